@@ -4,6 +4,18 @@
 #include "ble_db_discovery.h"
 #include "ble_types.h"
 #include "ble_gattc.h"
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_STATS)
+#include "ble_cscs_c_stats.h"
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONN_POLICY)
+#include "ble_cscs_c_conn_policy.h"
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONTINUITY)
+#include "ble_cscs_c_continuity.h"
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DEFERRED) && NRF_MODULE_ENABLED(BLE_CSCS_C_FILTER)
+#include "app_util_platform.h"
+#endif
 
 #define NRF_LOG_MODULE_NAME ble_cscs_c
 #include "nrf_log.h"
@@ -11,9 +23,77 @@ NRF_LOG_MODULE_REGISTER();
 
 #define CSCM_FLAG_WHEEL_PRESENT  (0x01 << 0)           /**< Bit mask used to extract the presence of Wheel Revolution Data. */
 #define CSCM_FLAG_CRANK_PRESENT  (0x01 << 1)           /**< Bit mask used to extract the presence of Crank Revolution Data. */
+#define CSCM_FLAG_LAYOUT_MASK    (CSCM_FLAG_WHEEL_PRESENT | CSCM_FLAG_CRANK_PRESENT) /**< Bit mask used to select the measurement layout. */
+#define CSCM_FLAG_SUPPORTED_MASK ((BLE_CSCS_C_WHEEL_SUPPORTED ? CSCM_FLAG_WHEEL_PRESENT : 0) | \
+                                  (BLE_CSCS_C_CRANK_SUPPORTED ? CSCM_FLAG_CRANK_PRESENT : 0)) /**< Bit mask of the fields decoded in this build. */
+
+#define CSCM_FLAGS_LEN           sizeof(uint8_t)                         /**< Length of the Flags field. */
+#define CSCM_WHEEL_DATA_LEN      (sizeof(uint32_t) + sizeof(uint16_t))   /**< Length of the Wheel Revolution Data fields. */
+#define CSCM_CRANK_DATA_LEN      (sizeof(uint16_t) + sizeof(uint16_t))   /**< Length of the Crank Revolution Data fields. */
 
 #define WRITE_MESSAGE_LENGTH   BLE_CCCD_VALUE_LEN    /**< Length of the write message for CCCD. */
 
+#define SETUP_CCCD             (0x01 << 0)           /**< Setup is waiting for the response to the CCCD write. */
+#define SETUP_FEATURE          (0x01 << 1)           /**< Setup is waiting for the response to the CSC Feature read. */
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+#define SETUP_SENSLOC          (0x01 << 2)           /**< Setup is waiting for the response to the Sensor Location read. */
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_COUNTERS)
+#ifndef BLE_CSCS_C_CYCLE_COUNT_GET
+#define BLE_CSCS_C_CYCLE_COUNT_GET()  (DWT->CYCCNT)     /**< Cycle counter used to time the event handler. The application must enable DWT->CYCCNT. */
+#endif
+#define COUNTER_INC(_p_ble_cscs_c, _counter)  ((_p_ble_cscs_c)->counters._counter++)  /**< Increments a performance counter. */
+#else
+#define COUNTER_INC(_p_ble_cscs_c, _counter)
+#endif
+
+#define CALC_EVENT_TIME_UNITS   1024                  /**< Resolution of the Last Wheel and Crank Event Time fields, in units per second. */
+#define CALC_WHEEL_REVS_MAX     1023                  /**< Largest wheel revolution count between two events that is accepted as valid. */
+#define CALC_CRANK_REVS_MAX     255                   /**< Largest crank revolution count between two events that is accepted as valid. */
+#define CALC_CADENCE_SCALE      (60 * 10)             /**< Conversion from revolutions per second to 1/10 rpm. */
+
+#define CONTINUITY_WHEEL_RATE_MAX  32                 /**< Highest wheel rate accepted over a disconnection, in revolutions per second. */
+#define CONTINUITY_CRANK_RATE_MAX  4                  /**< Highest crank rate accepted over a disconnection, in revolutions per second. */
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CALC) && BLE_CSCS_C_WHEEL_SUPPORTED
+// Keep the speed computation within 32 bits.
+STATIC_ASSERT((uint64_t)CALC_WHEEL_REVS_MAX * BLE_CSCS_C_WHEEL_CIRCUMFERENCE_MAX * CALC_EVENT_TIME_UNITS <= UINT32_MAX, "Speed computation overflows.");
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DEFERRED)
+STATIC_ASSERT(IS_POWER_OF_TWO(BLE_CSCS_C_DEFERRED_QUEUE_SIZE), "BLE_CSCS_C_DEFERRED_QUEUE_SIZE must be a power of two.");
+#endif
+
+/**@brief   Layout of a Cycling Speed and Cadence Measurement for one combination of flags. */
+typedef struct
+{
+    uint8_t wheel_offset;  /**< Offset of the Cumulative Wheel Revolutions field. */
+    uint8_t crank_offset;  /**< Offset of the Cumulative Crank Revolutions field. */
+    uint8_t len;           /**< Minimum length of a measurement with this layout. */
+} cscm_layout_t;
+
+/**@brief   Measurement layouts, indexed by the Wheel and Crank Revolution Data Present flags. */
+static const cscm_layout_t m_cscm_layouts[CSCM_FLAG_LAYOUT_MASK + 1] =
+{
+    {
+        .len          = CSCM_FLAGS_LEN
+    },
+    {
+        .wheel_offset = CSCM_FLAGS_LEN,
+        .len          = CSCM_FLAGS_LEN + CSCM_WHEEL_DATA_LEN
+    },
+    {
+        .crank_offset = CSCM_FLAGS_LEN,
+        .len          = CSCM_FLAGS_LEN + CSCM_CRANK_DATA_LEN
+    },
+    {
+        .wheel_offset = CSCM_FLAGS_LEN,
+        .crank_offset = CSCM_FLAGS_LEN + CSCM_WHEEL_DATA_LEN,
+        .len          = CSCM_FLAGS_LEN + CSCM_WHEEL_DATA_LEN + CSCM_CRANK_DATA_LEN
+    },
+};
+
 static void gatt_error_handler(uint32_t   nrf_error,
                                void     * p_ctx,
                                uint16_t   conn_handle)
@@ -21,6 +101,7 @@ static void gatt_error_handler(uint32_t   nrf_error,
     ble_cscs_c_t * p_ble_cscs_c = (ble_cscs_c_t *)p_ctx;
 
     NRF_LOG_DEBUG("A GATT Client error has occurred on conn_handle: 0X%X", conn_handle);
+    COUNTER_INC(p_ble_cscs_c, gatt_error_count);
 
     if (p_ble_cscs_c->error_handler != NULL)
     {
@@ -28,225 +109,1979 @@ static void gatt_error_handler(uint32_t   nrf_error,
     }
 }
 
-/**@brief     Function for handling Handle Value Notification received from the SoftDevice.
+/**@brief     Function for decoding a Cycling Speed and Cadence Measurement.
  *
- * @details   This function uses the Handle Value Notification received from the SoftDevice
- *            and checks whether it is a notification of the Cycling Speed and Cadence measurement from
- *            the peer. If it is, this function decodes the Cycling Speed measurement and sends it
- *            to the application.
+ * @details   The layout of the measurement is looked up from the flags byte, so the length
+ *            of the payload is validated once before any field is read.
+ *
+ * @param[in]  p_data     Pointer to the measurement payload.
+ * @param[in]  len        Length of the measurement payload.
+ * @param[in]  flags_mask Presence flags of the fields to decode. Fields the peer does not
+ *                        support are skipped even if their flag is set.
+ * @param[out] p_meas     Decoded measurement.
+ *
+ * @retval     true   If the measurement was decoded.
+ * @retval     false  If the payload is too short for the layout given by its flags.
+ */
+static bool csc_meas_decode(uint8_t const     * p_data,
+                            uint16_t            len,
+                            uint8_t             flags_mask,
+                            ble_cscs_c_meas_t * p_meas)
+{
+    if (len < CSCM_FLAGS_LEN)
+    {
+        return false;
+    }
+
+    uint8_t               flags    = p_data[0];
+    cscm_layout_t const * p_layout = &m_cscm_layouts[flags & CSCM_FLAG_LAYOUT_MASK];
+
+    if (len < p_layout->len)
+    {
+        return false;
+    }
+
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    p_meas->is_wheel_rev_data_present = (flags & flags_mask & CSCM_FLAG_WHEEL_PRESENT) != 0;
+
+    if (p_meas->is_wheel_rev_data_present)
+    {
+        p_meas->cumulative_wheel_revs = uint32_decode(&p_data[p_layout->wheel_offset]);
+        p_meas->last_wheel_event_time = uint16_decode(&p_data[p_layout->wheel_offset + sizeof(uint32_t)]);
+    }
+#endif
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    p_meas->is_crank_rev_data_present = (flags & flags_mask & CSCM_FLAG_CRANK_PRESENT) != 0;
+
+    if (p_meas->is_crank_rev_data_present)
+    {
+        p_meas->cumulative_crank_revs = uint16_decode(&p_data[p_layout->crank_offset]);
+        p_meas->last_crank_event_time = uint16_decode(&p_data[p_layout->crank_offset + sizeof(uint16_t)]);
+    }
+#endif
+
+    return true;
+}
+
+/**@brief     Function for passing an event to the application.
+ *
+ * @details   When performance counters are enabled, the execution time of the event handler is
+ *            measured with @ref BLE_CSCS_C_CYCLE_COUNT_GET.
  *
  * @param[in] p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
- * @param[in] p_ble_evt    Pointer to the BLE event received.
+ * @param[in] p_evt        Event to pass to the application.
  */
-static void on_hvx(ble_cscs_c_t * p_ble_cscs_c, const ble_evt_t * p_ble_evt)
+static void evt_handler_call(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
 {
-    const ble_gattc_evt_hvx_t * p_notif = &p_ble_evt->evt.gattc_evt.params.hvx;
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_COUNTERS)
+    ble_cscs_c_counters_t * p_counters = &p_ble_cscs_c->counters;
+    uint32_t                start      = BLE_CSCS_C_CYCLE_COUNT_GET();
 
-    // Check if the event is on the link for this instance
-    if (p_ble_cscs_c->conn_handle != p_ble_evt->evt.gattc_evt.conn_handle)
+    p_ble_cscs_c->evt_handler(p_ble_cscs_c, p_evt);
+
+    uint32_t cycles = BLE_CSCS_C_CYCLE_COUNT_GET() - start;
+
+    p_counters->handler_call_count++;
+    p_counters->handler_cycles_sum += cycles;
+    p_counters->handler_cycles_min  = MIN(p_counters->handler_cycles_min, cycles);
+    p_counters->handler_cycles_max  = MAX(p_counters->handler_cycles_max, cycles);
+#else
+    p_ble_cscs_c->evt_handler(p_ble_cscs_c, p_evt);
+#endif
+}
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DEFERRED)
+/**@brief     Function for queuing a decoded measurement for @ref ble_cscs_c_drain.
+ *
+ * @param[in] p_queue Pointer to the measurement queue.
+ * @param[in] p_meas  Measurement to queue.
+ */
+static void meas_queue_put(ble_cscs_c_meas_queue_t * p_queue, ble_cscs_c_meas_t const * p_meas)
+{
+    uint32_t wr_idx = p_queue->wr_idx;
+
+    if ((wr_idx - p_queue->rd_idx) >= BLE_CSCS_C_DEFERRED_QUEUE_SIZE)
     {
+        p_queue->overflow_count++;
         return;
     }
 
-    if (p_ble_evt->evt.gattc_evt.params.hvx.handle == p_ble_cscs_c->peer_db.cscs_handle)
+    p_queue->meas[wr_idx & (BLE_CSCS_C_DEFERRED_QUEUE_SIZE - 1)] = *p_meas;
+
+    // Make the measurement visible before publishing the new write index.
+    __DMB();
+    p_queue->wr_idx = wr_idx + 1;
+}
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CALC)
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+/**@brief     Function for updating the speed and distance from the wheel fields of a measurement.
+ *
+ * @details   A new wheel event is detected by a change of the cumulative revolutions. If
+ *            @ref BLE_CSCS_C_CALC_STOP_COUNT measurements arrive without one, the wheel is
+ *            considered stopped and the speed is 0. The first event after a stop only moves the
+ *            reference, because the event time may have wrapped more than once while stopped.
+ *
+ * @param[in]     circumference Wheel circumference in mm.
+ * @param[in,out] p_state       Calculation state.
+ * @param[in]     p_meas        Decoded measurement.
+ */
+static void calc_wheel_update(uint16_t                  circumference,
+                              ble_cscs_c_calc_state_t * p_state,
+                              ble_cscs_c_meas_t const * p_meas)
+{
+    if (!p_state->is_wheel_ref_valid)
     {
-        uint32_t         index = 0;
-        ble_cscs_c_evt_t ble_cscs_c_evt;
+        p_state->is_wheel_ref_valid = true;
+        p_state->wheel_revs         = p_meas->cumulative_wheel_revs;
+        p_state->wheel_event_time   = p_meas->last_wheel_event_time;
+        p_state->wheel_stall_count  = BLE_CSCS_C_CALC_STOP_COUNT;
+        p_state->speed              = 0;
+        return;
+    }
+
+    uint32_t revs = p_meas->cumulative_wheel_revs - p_state->wheel_revs;
+    uint16_t time = (uint16_t)(p_meas->last_wheel_event_time - p_state->wheel_event_time);
 
-        ble_cscs_c_evt.params.csc.is_wheel_rev_data_present = p_notif->data[index] & CSCM_FLAG_WHEEL_PRESENT;
-        ble_cscs_c_evt.params.csc.is_crank_rev_data_present = p_notif->data[index] & CSCM_FLAG_CRANK_PRESENT;
-        index++;
+    if (revs > CALC_WHEEL_REVS_MAX)
+    {
+        // Sensor reset or corrupted counter, start over from this measurement.
+        p_state->is_wheel_ref_valid = false;
+        calc_wheel_update(circumference, p_state, p_meas);
+        return;
+    }
 
-        if(ble_cscs_c_evt.params.csc.is_wheel_rev_data_present)
+    if (revs == 0)
+    {
+        if (p_state->wheel_stall_count < BLE_CSCS_C_CALC_STOP_COUNT)
         {
-            ble_cscs_c_evt.params.csc.cumulative_wheel_revs = uint32_decode(&p_notif->data[index]);
-            index += sizeof(uint32_t);
-            ble_cscs_c_evt.params.csc.last_wheel_event_time = uint16_decode(&p_notif->data[index]);
-            index += sizeof(uint16_t);
+            p_state->wheel_stall_count++;
         }
-        if(ble_cscs_c_evt.params.csc.is_crank_rev_data_present)
+        if (p_state->wheel_stall_count >= BLE_CSCS_C_CALC_STOP_COUNT)
         {
-            ble_cscs_c_evt.params.csc.cumulative_crank_revs = uint16_decode(&p_notif->data[index]);
-            index += sizeof(uint16_t);
-            ble_cscs_c_evt.params.csc.last_crank_event_time = uint16_decode(&p_notif->data[index]);
-            index += sizeof(uint16_t);
+            p_state->speed = 0;
         }
+        return;
+    }
 
-        ble_cscs_c_evt.evt_type    = BLE_CSCS_C_EVT_CSM_NOTIFICATION;
-        ble_cscs_c_evt.conn_handle = p_ble_evt->evt.gattc_evt.conn_handle;
-        p_ble_cscs_c->evt_handler(p_ble_cscs_c, &ble_cscs_c_evt);
+    p_state->distance_rem += revs * circumference % 1000;
+    p_state->distance     += revs * circumference / 1000 + p_state->distance_rem / 1000;
+    p_state->distance_rem %= 1000;
+
+    if ((time != 0) && (p_state->wheel_stall_count < BLE_CSCS_C_CALC_STOP_COUNT))
+    {
+        p_state->speed = revs * circumference * CALC_EVENT_TIME_UNITS / time;
     }
+
+    p_state->wheel_revs        = p_meas->cumulative_wheel_revs;
+    p_state->wheel_event_time  = p_meas->last_wheel_event_time;
+    p_state->wheel_stall_count = 0;
 }
+#endif
 
-/**@brief     Function for handling events from the Database Discovery module.
- *
- * @details   This function handles an event from the Database Discovery module, and determines
- *            whether it relates to the discovery of Cycling Speed and Cadence service at the peer. If it does, the function
- *            calls the application's event handler to indicate that the Cycling Speed and Cadence
- *            service was discovered at the peer. The function also populates the event with service-related
- * 			  information before providing it to the application.
+#if BLE_CSCS_C_CRANK_SUPPORTED
+/**@brief     Function for updating the cadence from the crank fields of a measurement.
  *
- * @param[in] p_evt Pointer to the event received from the Database Discovery module.
+ * @details   Works like @ref calc_wheel_update, with a 16-bit revolution counter.
  *
+ * @param[in,out] p_state Calculation state.
+ * @param[in]     p_meas  Decoded measurement.
  */
-void ble_cscs_on_db_disc_evt(ble_cscs_c_t * p_ble_cscs_c, const ble_db_discovery_evt_t * p_evt)
+static void calc_crank_update(ble_cscs_c_calc_state_t * p_state, ble_cscs_c_meas_t const * p_meas)
 {
-        // Check if the Cycling Speed and Cadence Service was discovered.
-    if (p_evt->evt_type == BLE_DB_DISCOVERY_COMPLETE &&
-        p_evt->params.discovered_db.srv_uuid.uuid == BLE_UUID_CYCLING_SPEED_AND_CADENCE &&
-        p_evt->params.discovered_db.srv_uuid.type == BLE_UUID_TYPE_BLE)
+    if (!p_state->is_crank_ref_valid)
     {
-        ble_cscs_c_evt_t evt;
+        p_state->is_crank_ref_valid = true;
+        p_state->crank_revs         = p_meas->cumulative_crank_revs;
+        p_state->crank_event_time   = p_meas->last_crank_event_time;
+        p_state->crank_stall_count  = BLE_CSCS_C_CALC_STOP_COUNT;
+        p_state->cadence            = 0;
+        return;
+    }
 
-        for (uint32_t i = 0; i < p_evt->params.discovered_db.char_count; i++)
+    uint16_t revs = (uint16_t)(p_meas->cumulative_crank_revs - p_state->crank_revs);
+    uint16_t time = (uint16_t)(p_meas->last_crank_event_time - p_state->crank_event_time);
+
+    if (revs > CALC_CRANK_REVS_MAX)
+    {
+        p_state->is_crank_ref_valid = false;
+        calc_crank_update(p_state, p_meas);
+        return;
+    }
+
+    if (revs == 0)
+    {
+        if (p_state->crank_stall_count < BLE_CSCS_C_CALC_STOP_COUNT)
         {
-            switch (p_evt->params.discovered_db.charateristics[i].characteristic.uuid.uuid)
-            {
-                case BLE_UUID_CSC_MEASUREMENT_CHAR:
-                {
-                    evt.params.cscs_db.cscs_cccd_handle =
-                        p_evt->params.discovered_db.charateristics[i].cccd_handle;
-                    evt.params.cscs_db.cscs_handle      =
-                        p_evt->params.discovered_db.charateristics[i].characteristic.handle_value;
-                    break;
-                }
-                case BLE_UUID_CSC_FEATURE_CHAR:
-                {
-                    evt.params.cscs_db.cscs_feature_handle =
-                        p_evt->params.discovered_db.charateristics[i].characteristic.handle_value;
-                    break;
-                }
-                case BLE_UUID_SENSOR_LOCATION_CHAR:
-                {
-                    evt.params.cscs_db.cscs_sensloc_handle =
-                        p_evt->params.discovered_db.charateristics[i].characteristic.handle_value;
-                    break;
-                }
-            }
+            p_state->crank_stall_count++;
         }
-        evt.evt_type = BLE_CSCS_C_EVT_DISCOVERY_COMPLETE;
-        evt.conn_handle = p_evt->conn_handle;
-        p_ble_cscs_c->evt_handler(p_ble_cscs_c, &evt);
+        if (p_state->crank_stall_count >= BLE_CSCS_C_CALC_STOP_COUNT)
+        {
+            p_state->cadence = 0;
+        }
+        return;
+    }
+
+    if ((time != 0) && (p_state->crank_stall_count < BLE_CSCS_C_CALC_STOP_COUNT))
+    {
+        uint32_t cadence = (uint32_t)revs * CALC_CADENCE_SCALE * CALC_EVENT_TIME_UNITS / time;
+
+        p_state->cadence = (uint16_t)MIN(cadence, UINT16_MAX);
     }
+
+    p_state->crank_revs        = p_meas->cumulative_crank_revs;
+    p_state->crank_event_time  = p_meas->last_crank_event_time;
+    p_state->crank_stall_count = 0;
 }
+#endif
 
-uint32_t ble_cscs_c_init(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_init_t * p_ble_cscs_c_init)
+/**@brief     Function for deriving speed, cadence and distance from a decoded measurement.
+ *
+ * @param[in]     p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ * @param[in,out] p_meas       Decoded measurement, its @p calc field is filled in.
+ */
+static void calc_update(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_meas_t * p_meas)
 {
-    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
-    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c_init);
-
-    ble_uuid_t cscs_uuid;
+    ble_cscs_c_calc_state_t * p_state = &p_ble_cscs_c->calc_state;
 
-    cscs_uuid.type = BLE_UUID_TYPE_BLE;
-    cscs_uuid.uuid = BLE_UUID_CYCLING_SPEED_AND_CADENCE;
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    p_meas->calc.is_speed_valid = false;
 
-    p_ble_cscs_c->evt_handler              = p_ble_cscs_c_init->evt_handler;
-    p_ble_cscs_c->error_handler            = p_ble_cscs_c_init->error_handler;
-    p_ble_cscs_c->conn_handle              = BLE_CONN_HANDLE_INVALID;
-    p_ble_cscs_c->peer_db.cscs_cccd_handle = BLE_GATT_HANDLE_INVALID;
-    p_ble_cscs_c->peer_db.cscs_handle      = BLE_GATT_HANDLE_INVALID;
-    p_ble_cscs_c->p_gatt_queue             = p_ble_cscs_c_init->p_gatt_queue;
+    if (p_meas->is_wheel_rev_data_present && (p_ble_cscs_c->wheel_circumference != 0))
+    {
+        calc_wheel_update(p_ble_cscs_c->wheel_circumference, p_state, p_meas);
+        p_meas->calc.is_speed_valid = true;
+    }
 
-    return ble_db_discovery_evt_register(&cscs_uuid);
-}
+    p_meas->calc.speed    = p_state->speed;
+    p_meas->calc.distance = p_state->distance;
+#endif
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    p_meas->calc.is_cadence_valid = false;
 
-uint32_t ble_cscs_c_handles_assign(ble_cscs_c_t *    p_ble_cscs_c,
-                                   uint16_t          conn_handle,
-                                   ble_cscs_c_db_t * p_peer_handles)
-{
-    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
-    p_ble_cscs_c->conn_handle = conn_handle;
-    if (p_peer_handles != NULL)
+    if (p_meas->is_crank_rev_data_present)
     {
-        p_ble_cscs_c->peer_db = *p_peer_handles;
+        calc_crank_update(p_state, p_meas);
+        p_meas->calc.is_cadence_valid = true;
     }
 
-    return nrf_ble_gq_conn_handle_register(p_ble_cscs_c->p_gatt_queue, conn_handle);
+    p_meas->calc.cadence = p_state->cadence;
+#endif
 }
+#endif
 
-/**@brief     Function for handling Disconnected event received from the SoftDevice.
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONTINUITY)
+/**@brief     Function for getting the largest revolution count that is plausible over a gap.
  *
- * @details   This function check whether the disconnect event is happening on the link
- *            associated with the current instance of the module. If the event is happening, the function sets the instance's
- *            conn_handle to invalid.
+ * @param[in] gap_ms    Duration of the gap, in ms.
+ * @param[in] rate_max  Highest revolution rate, in revolutions per second.
+ * @param[in] revs_max  Largest revolution count between two events.
  *
- * @param[in] p_ble_rscs_c Pointer to the RSC Client structure.
- * @param[in] p_ble_evt   Pointer to the BLE event received.
+ * @return    Largest plausible revolution count.
  */
-static void on_disconnected(ble_cscs_c_t * p_ble_cscs_c, const ble_evt_t * p_ble_evt)
+static uint32_t continuity_revs_max(uint32_t gap_ms, uint32_t rate_max, uint32_t revs_max)
 {
-    if (p_ble_cscs_c->conn_handle == p_ble_evt->evt.gap_evt.conn_handle)
+    return revs_max + (gap_ms / 1000) * rate_max;
+}
+
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+/**@brief     Function for continuing the wheel counter and the distance of the previous link.
+ *
+ * @details   The distance is always continued. The revolutions since the last wheel event of the
+ *            previous link are credited if they are plausible for the gap; the 32-bit difference
+ *            handles counter wraparound. Otherwise the sensor was reset, and the revolutions it
+ *            counted since are credited if they are plausible. The speed starts over, because the
+ *            event time may have wrapped during the gap.
+ *
+ * @param[in]  p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ * @param[in]  p_saved      Calculation state of the previous link.
+ * @param[in]  gap_ms       Duration of the gap, in ms.
+ * @param[in]  p_meas       First measurement of the new link.
+ * @param[out] p_revs       Revolutions credited to the distance.
+ *
+ * @return     Outcome for the wheel counter.
+ */
+static ble_cscs_c_continuity_result_t continuity_wheel_reconcile(ble_cscs_c_t                  * p_ble_cscs_c,
+                                                                 ble_cscs_c_calc_state_t const * p_saved,
+                                                                 uint32_t                        gap_ms,
+                                                                 ble_cscs_c_meas_t const       * p_meas,
+                                                                 uint32_t                      * p_revs)
+{
+    ble_cscs_c_calc_state_t      * p_state  = &p_ble_cscs_c->calc_state;
+    uint32_t                       revs_max = continuity_revs_max(gap_ms, CONTINUITY_WHEEL_RATE_MAX, CALC_WHEEL_REVS_MAX);
+    uint32_t                       revs     = p_meas->cumulative_wheel_revs - p_saved->wheel_revs;
+    ble_cscs_c_continuity_result_t result   = BLE_CSCS_C_CONTINUITY_RESUMED;
+
+    p_state->distance     = p_saved->distance;
+    p_state->distance_rem = p_saved->distance_rem;
+    *p_revs               = 0;
+
+    if (!p_saved->is_wheel_ref_valid || !p_meas->is_wheel_rev_data_present ||
+        (p_ble_cscs_c->wheel_circumference == 0))
     {
-        p_ble_cscs_c->conn_handle              = BLE_CONN_HANDLE_INVALID;
-        p_ble_cscs_c->peer_db.cscs_cccd_handle = BLE_GATT_HANDLE_INVALID;
-        p_ble_cscs_c->peer_db.cscs_handle      = BLE_GATT_HANDLE_INVALID;
+        return BLE_CSCS_C_CONTINUITY_NONE;
+    }
+
+    if (revs > revs_max)
+    {
+        result = BLE_CSCS_C_CONTINUITY_RESET;
+        revs   = (p_meas->cumulative_wheel_revs <= revs_max) ? p_meas->cumulative_wheel_revs : 0;
     }
+
+    uint64_t distance_mm = (uint64_t)revs * p_ble_cscs_c->wheel_circumference + p_state->distance_rem;
+
+    p_state->distance          += (uint32_t)(distance_mm / 1000);
+    p_state->distance_rem       = (uint16_t)(distance_mm % 1000);
+    p_state->is_wheel_ref_valid = true;
+    p_state->wheel_revs         = p_meas->cumulative_wheel_revs;
+    p_state->wheel_event_time   = p_meas->last_wheel_event_time;
+    p_state->wheel_stall_count  = BLE_CSCS_C_CALC_STOP_COUNT;
+    p_state->speed              = 0;
+    *p_revs                     = revs;
+
+    return result;
 }
+#endif
 
-void ble_cscs_c_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context)
+#if BLE_CSCS_C_CRANK_SUPPORTED
+/**@brief     Function for continuing the crank counter of the previous link.
+ *
+ * @details   Works like @ref continuity_wheel_reconcile, with a 16-bit counter. A sensor reset
+ *            cannot be told from wraparound once the gap is long enough for the counter to wrap.
+ *
+ * @param[in]  p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ * @param[in]  p_saved      Calculation state of the previous link.
+ * @param[in]  gap_ms       Duration of the gap, in ms.
+ * @param[in]  p_meas       First measurement of the new link.
+ * @param[out] p_revs       Crank revolutions over the gap.
+ *
+ * @return     Outcome for the crank counter.
+ */
+static ble_cscs_c_continuity_result_t continuity_crank_reconcile(ble_cscs_c_t                  * p_ble_cscs_c,
+                                                                 ble_cscs_c_calc_state_t const * p_saved,
+                                                                 uint32_t                        gap_ms,
+                                                                 ble_cscs_c_meas_t const       * p_meas,
+                                                                 uint16_t                      * p_revs)
 {
-    ble_cscs_c_evt_t evt;
-    if ((p_context == NULL) || (p_ble_evt == NULL))
+    ble_cscs_c_calc_state_t      * p_state  = &p_ble_cscs_c->calc_state;
+    uint32_t                       revs_max = continuity_revs_max(gap_ms, CONTINUITY_CRANK_RATE_MAX, CALC_CRANK_REVS_MAX);
+    uint16_t                       revs     = (uint16_t)(p_meas->cumulative_crank_revs - p_saved->crank_revs);
+    ble_cscs_c_continuity_result_t result   = BLE_CSCS_C_CONTINUITY_RESUMED;
+
+    *p_revs = 0;
+
+    if (!p_saved->is_crank_ref_valid || !p_meas->is_crank_rev_data_present)
     {
-        return;
+        return BLE_CSCS_C_CONTINUITY_NONE;
     }
 
-    ble_cscs_c_t * p_ble_cscs_c = (ble_cscs_c_t *)p_context;
-
-    switch (p_ble_evt->header.evt_id)
+    if (revs > revs_max)
     {
-        case BLE_GATTC_EVT_HVX:
-            on_hvx(p_ble_cscs_c, p_ble_evt);
-            break;
-        case BLE_GAP_EVT_DISCONNECTED:
-            on_disconnected(p_ble_cscs_c, p_ble_evt);
-            break;
-        default:
-            break;
+        result = BLE_CSCS_C_CONTINUITY_RESET;
+        revs   = (p_meas->cumulative_crank_revs <= revs_max) ? p_meas->cumulative_crank_revs : 0;
     }
+
+    p_state->is_crank_ref_valid = true;
+    p_state->crank_revs         = p_meas->cumulative_crank_revs;
+    p_state->crank_event_time   = p_meas->last_crank_event_time;
+    p_state->crank_stall_count  = BLE_CSCS_C_CALC_STOP_COUNT;
+    p_state->cadence            = 0;
+    *p_revs                     = revs;
+
+    return result;
 }
+#endif
 
-/**@brief Function for creating a message for writing to the CCCD.
+/**@brief     Function for continuing the counters of the previous link to the same peer.
+ *
+ * @details   Called with the first measurement of a link, before @ref calc_update. If the peer is
+ *            in the continuity table, its state is reconciled with the measurement and
+ *            @ref BLE_CSCS_C_EVT_CONTINUITY is sent to the application.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ * @param[in] p_meas       First measurement of the link.
  */
-static uint32_t cccd_configure(ble_cscs_c_t * p_ble_cscs_c, bool enable)
+static void continuity_reconcile(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_meas_t const * p_meas)
 {
-    NRF_LOG_DEBUG("Configuring CCCD. CCCD Handle = %d, Connection Handle = %d",
-                  p_ble_cscs_c->peer_db.cscs_cccd_handle,
-                  p_ble_cscs_c->conn_handle);
+    ble_cscs_c_continuity_entry_t const * p_entry;
+    ble_cscs_c_evt_t                      evt;
 
-    uint8_t          cccd[WRITE_MESSAGE_LENGTH];
-    uint16_t         cccd_val = enable ? BLE_GATT_HVX_NOTIFICATION : 0;
-    nrf_ble_gq_req_t cscs_c_req;
+    p_ble_cscs_c->is_continuity_pending = false;
 
-    cccd[0] = LSB_16(cccd_val);
-    cccd[1] = MSB_16(cccd_val);
+    p_entry = ble_cscs_c_continuity_find(p_ble_cscs_c->p_continuity, &p_ble_cscs_c->peer_addr);
+    if (p_entry == NULL)
+    {
+        return;
+    }
 
-    memset(&cscs_c_req, 0, sizeof(cscs_c_req));
-    cscs_c_req.type                        = NRF_BLE_GQ_REQ_GATTC_WRITE;
-    cscs_c_req.error_handler.cb            = gatt_error_handler;
-    cscs_c_req.error_handler.p_ctx         = p_ble_cscs_c;
-    cscs_c_req.params.gattc_write.handle   = p_ble_cscs_c->peer_db.cscs_cccd_handle;
-    cscs_c_req.params.gattc_write.len      = WRITE_MESSAGE_LENGTH;
-    cscs_c_req.params.gattc_write.p_value  = cccd;
-    cscs_c_req.params.gattc_write.offset   = 0;
-    cscs_c_req.params.gattc_write.write_op = BLE_GATT_OP_WRITE_REQ;
-    cscs_c_req.params.gattc_write.flags    = BLE_GATT_EXEC_WRITE_FLAG_PREPARED_WRITE;
+    ble_cscs_c_continuity_info_t * p_info = &evt.params.continuity;
 
-    return nrf_ble_gq_item_add(p_ble_cscs_c->p_gatt_queue, &cscs_c_req, p_ble_cscs_c->conn_handle);
+    p_info->gap_ms = p_ble_cscs_c->timestamp_get() - p_entry->disconnect_time;
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    p_info->wheel_result = continuity_wheel_reconcile(p_ble_cscs_c,
+                                                      &p_entry->calc_state,
+                                                      p_info->gap_ms,
+                                                      p_meas,
+                                                      &p_info->wheel_revs);
+#endif
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    p_info->crank_result = continuity_crank_reconcile(p_ble_cscs_c,
+                                                      &p_entry->calc_state,
+                                                      p_info->gap_ms,
+                                                      p_meas,
+                                                      &p_info->crank_revs);
+#endif
+
+    NRF_LOG_DEBUG("Counters continued after a gap of %d ms", p_info->gap_ms);
+
+    evt.evt_type    = BLE_CSCS_C_EVT_CONTINUITY;
+    evt.conn_handle = p_ble_cscs_c->conn_handle;
+    evt_handler_call(p_ble_cscs_c, &evt);
 }
+#endif
 
-uint32_t ble_cscs_c_csm_notif_enable(ble_cscs_c_t * p_ble_cscs_c)
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CAPTURE)
+/**@brief     Function for copying bytes into the capture buffer, wrapping at its end.
+ *
+ * @param[in] p_capture Pointer to the capture buffer.
+ * @param[in] idx       Free running index to start writing at.
+ * @param[in] p_src     Bytes to copy.
+ * @param[in] len       Number of bytes to copy.
+ */
+static void capture_copy(ble_cscs_c_capture_t * p_capture, uint32_t idx, uint8_t const * p_src, uint32_t len)
 {
-    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
+    uint32_t offset = idx & (p_capture->size - 1);
+    uint32_t first  = MIN(len, p_capture->size - offset);
 
-    if (p_ble_cscs_c->conn_handle == BLE_CONN_HANDLE_INVALID)
+    memcpy(&p_capture->p_data[offset], p_src, first);
+    memcpy(p_capture->p_data, &p_src[first], len - first);
+}
+
+/**@brief     Function for capturing a raw notification.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ * @param[in] p_gattc_evt  GATT Client event containing the notification.
+ */
+static void capture_put(ble_cscs_c_t * p_ble_cscs_c, ble_gattc_evt_t const * p_gattc_evt)
+{
+    ble_cscs_c_capture_t      * p_capture = p_ble_cscs_c->p_capture;
+    ble_gattc_evt_hvx_t const * p_notif   = &p_gattc_evt->params.hvx;
+    uint8_t                     header[BLE_CSCS_C_CAPTURE_HEADER_LEN];
+    uint32_t                    len       = MIN(p_notif->len, UINT8_MAX);
+    uint32_t                    wr_idx    = p_capture->wr_idx;
+    uint32_t                    timestamp = 0;
+
+    if ((BLE_CSCS_C_CAPTURE_HEADER_LEN + len) > (p_capture->size - (wr_idx - p_capture->rd_idx)))
     {
-        return NRF_ERROR_INVALID_STATE;
+        p_capture->dropped_count++;
+        return;
     }
 
-    return cccd_configure(p_ble_cscs_c, true);
+    if (p_ble_cscs_c->timestamp_get != NULL)
+    {
+        timestamp = p_ble_cscs_c->timestamp_get();
+    }
+
+    header[0] = (uint8_t)len;
+    (void)uint32_encode(timestamp, &header[1]);
+    (void)uint16_encode(p_gattc_evt->conn_handle, &header[5]);
+    (void)uint16_encode(p_notif->handle, &header[7]);
+
+    capture_copy(p_capture, wr_idx, header, sizeof(header));
+    capture_copy(p_capture, wr_idx + sizeof(header), p_notif->data, len);
+
+    // Make the record visible before publishing the new write index.
+    __DMB();
+    p_capture->wr_idx = wr_idx + sizeof(header) + len;
 }
+#endif
 
+/**@brief     Function for passing a decoded measurement to the application.
+ *
+ * @details   The measurement is queued for @ref ble_cscs_c_drain in deferred delivery mode, and
+ *            passed to the event handler otherwise.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ * @param[in] p_evt        Event with the measurement filled in.
+ */
+static void meas_deliver(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DEFERRED)
+    meas_queue_put(&p_ble_cscs_c->meas_queue, &p_evt->params.csc);
+#else
+    p_evt->evt_type    = BLE_CSCS_C_EVT_CSM_NOTIFICATION;
+    p_evt->conn_handle = p_ble_cscs_c->conn_handle;
+    evt_handler_call(p_ble_cscs_c, p_evt);
+#endif
+}
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_FILTER)
+/**@brief     Function for checking whether two measurements differ.
+ *
+ * @param[in] p_meas1        First measurement.
+ * @param[in] p_meas2        Second measurement.
+ * @param[in] cmp_event_time True to compare the event times, false to compare only the
+ *                           cumulative values.
+ *
+ * @return    True if the measurements differ.
+ */
+static bool meas_differ(ble_cscs_c_meas_t const * p_meas1,
+                        ble_cscs_c_meas_t const * p_meas2,
+                        bool                      cmp_event_time)
+{
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    if ((p_meas1->is_wheel_rev_data_present != p_meas2->is_wheel_rev_data_present) ||
+        (p_meas1->is_wheel_rev_data_present &&
+         ((p_meas1->cumulative_wheel_revs != p_meas2->cumulative_wheel_revs) ||
+          (cmp_event_time && (p_meas1->last_wheel_event_time != p_meas2->last_wheel_event_time)))))
+    {
+        return true;
+    }
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CALC)
+    // A sensor that stopped keeps repeating its counters while the speed drops to 0.
+    if ((p_meas1->calc.is_speed_valid != p_meas2->calc.is_speed_valid) ||
+        (p_meas1->calc.speed          != p_meas2->calc.speed))
+    {
+        return true;
+    }
+#endif
+#endif
+
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    if ((p_meas1->is_crank_rev_data_present != p_meas2->is_crank_rev_data_present) ||
+        (p_meas1->is_crank_rev_data_present &&
+         ((p_meas1->cumulative_crank_revs != p_meas2->cumulative_crank_revs) ||
+          (cmp_event_time && (p_meas1->last_crank_event_time != p_meas2->last_crank_event_time)))))
+    {
+        return true;
+    }
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CALC)
+    if ((p_meas1->calc.is_cadence_valid != p_meas2->calc.is_cadence_valid) ||
+        (p_meas1->calc.cadence          != p_meas2->calc.cadence))
+    {
+        return true;
+    }
+#endif
+#endif
+
+    return false;
+}
+
+/**@brief     Function for filtering a decoded measurement before it is passed to the application.
+ *
+ * @details   Depending on @ref ble_cscs_c_s::filter_mode, measurements that repeat the previous
+ *            one are dropped. If @ref ble_cscs_c_s::filter_interval is set, measurements arriving
+ *            less than that many ms after the last one passed on are held back, and the latest
+ *            held measurement is passed on with the next one that is let through or by
+ *            @ref ble_cscs_c_filter_flush.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ * @param[in] p_meas       Decoded measurement.
+ *
+ * @return    True if the measurement is to be passed to the application.
+ */
+static bool filter_pass(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_meas_t const * p_meas)
+{
+    ble_cscs_c_filter_t * p_filter = &p_ble_cscs_c->filter;
+
+    p_filter->rx_count++;
+
+    if (p_filter->is_last_valid && (p_ble_cscs_c->filter_mode != BLE_CSCS_C_FILTER_NONE))
+    {
+        bool cmp_event_time = (p_ble_cscs_c->filter_mode == BLE_CSCS_C_FILTER_DUPLICATES);
+
+        if (!meas_differ(&p_filter->last, p_meas, cmp_event_time))
+        {
+            return false;
+        }
+    }
+
+    p_filter->last          = *p_meas;
+    p_filter->is_last_valid = true;
+
+    if ((p_ble_cscs_c->filter_interval != 0) && (p_ble_cscs_c->timestamp_get != NULL))
+    {
+        uint32_t now = p_ble_cscs_c->timestamp_get();
+
+        if (p_filter->is_delivered && ((now - p_filter->delivered_time) < p_ble_cscs_c->filter_interval))
+        {
+            p_filter->is_pending = true;
+            return false;
+        }
+
+        p_filter->delivered_time = now;
+        p_filter->is_delivered   = true;
+    }
+
+    p_filter->is_pending = false;
+    p_filter->delivered_count++;
+
+    return true;
+}
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_SUSPEND)
+static uint32_t cccd_configure(ble_cscs_c_t * p_ble_cscs_c, bool enable);
+
+/**@brief     Function for sending an event about the auto-suspend policy to the application.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ * @param[in] evt_type     @ref BLE_CSCS_C_EVT_SUSPENDED or @ref BLE_CSCS_C_EVT_RESUMED.
+ */
+static void suspend_evt_send(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_type_t evt_type)
+{
+    ble_cscs_c_evt_t evt;
+
+    evt.evt_type    = evt_type;
+    evt.conn_handle = p_ble_cscs_c->conn_handle;
+    evt_handler_call(p_ble_cscs_c, &evt);
+}
+
+/**@brief     Function for queuing the CCCD write that turns notifications off.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ * @param[in] now          Current time, in ms.
+ */
+static void suspend_start(ble_cscs_c_t * p_ble_cscs_c, uint32_t now)
+{
+    ble_cscs_c_suspend_t * p_suspend = &p_ble_cscs_c->suspend;
+
+    if (cccd_configure(p_ble_cscs_c, false) != NRF_SUCCESS)
+    {
+        return;
+    }
+
+    p_suspend->state      = BLE_CSCS_C_SUSPEND_SUSPENDING;
+    p_suspend->state_time = now;
+    p_suspend->stats.cccd_write_count++;
+}
+
+/**@brief     Function for queuing the CCCD write that turns notifications back on.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ * @param[in] now          Current time, in ms.
+ *
+ * @return    Error code returned by @ref nrf_ble_gq_item_add.
+ */
+static uint32_t resume_start(ble_cscs_c_t * p_ble_cscs_c, uint32_t now)
+{
+    ble_cscs_c_suspend_t * p_suspend = &p_ble_cscs_c->suspend;
+    uint32_t               err_code  = cccd_configure(p_ble_cscs_c, true);
+
+    VERIFY_SUCCESS(err_code);
+
+    p_suspend->stats.suspended_time += now - p_suspend->state_time;
+    p_suspend->state                 = BLE_CSCS_C_SUSPEND_RESUMING;
+    p_suspend->state_time            = now;
+    p_suspend->stats.cccd_write_count++;
+
+    return NRF_SUCCESS;
+}
+
+/**@brief     Function for passing a decoded measurement to the auto-suspend policy.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ * @param[in] p_meas       Decoded measurement.
+ */
+static void suspend_on_meas(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_meas_t const * p_meas)
+{
+    ble_cscs_c_suspend_t * p_suspend = &p_ble_cscs_c->suspend;
+    uint32_t               now       = p_ble_cscs_c->timestamp_get();
+    bool                   changed   = !p_suspend->is_last_valid;
+
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    if (p_meas->is_wheel_rev_data_present)
+    {
+        changed               = changed || (p_meas->cumulative_wheel_revs != p_suspend->wheel_revs);
+        p_suspend->wheel_revs = p_meas->cumulative_wheel_revs;
+    }
+#endif
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    if (p_meas->is_crank_rev_data_present)
+    {
+        changed               = changed || (p_meas->cumulative_crank_revs != p_suspend->crank_revs);
+        p_suspend->crank_revs = p_meas->cumulative_crank_revs;
+    }
+#endif
+
+    // Skip intervals that span a state change, they include the time spent suspended.
+    if (p_suspend->is_last_valid &&
+        ((now - p_suspend->notif_time) < (now - p_suspend->state_time)))
+    {
+        uint32_t interval = now - p_suspend->notif_time;
+
+        p_suspend->notif_interval = (p_suspend->notif_interval == 0)
+                                    ? interval
+                                    : (p_suspend->notif_interval * 7 + interval) / 8;
+    }
+
+    p_suspend->is_last_valid = true;
+    p_suspend->notif_time    = now;
+
+    if (changed)
+    {
+        p_suspend->change_time = now;
+    }
+    else if ((p_suspend->state == BLE_CSCS_C_SUSPEND_ACTIVE) &&
+             ((now - p_suspend->change_time) >= p_ble_cscs_c->suspend_timeout))
+    {
+        suspend_start(p_ble_cscs_c, now);
+    }
+}
+
+/**@brief     Function for completing a CCCD write of the auto-suspend policy.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ * @param[in] success      True if the peer accepted the write.
+ */
+static void suspend_on_write_rsp(ble_cscs_c_t * p_ble_cscs_c, bool success)
+{
+    ble_cscs_c_suspend_t * p_suspend = &p_ble_cscs_c->suspend;
+    uint32_t               now       = p_ble_cscs_c->timestamp_get();
+
+    if (p_suspend->state == BLE_CSCS_C_SUSPEND_SUSPENDING)
+    {
+        p_suspend->state      = success ? BLE_CSCS_C_SUSPEND_SUSPENDED : BLE_CSCS_C_SUSPEND_ACTIVE;
+        p_suspend->state_time = now;
+        if (success)
+        {
+            p_suspend->stats.suspend_count++;
+            suspend_evt_send(p_ble_cscs_c, BLE_CSCS_C_EVT_SUSPENDED);
+        }
+    }
+    else if (p_suspend->state == BLE_CSCS_C_SUSPEND_RESUMING)
+    {
+        if (success)
+        {
+            p_suspend->state = BLE_CSCS_C_SUSPEND_ACTIVE;
+            suspend_evt_send(p_ble_cscs_c, BLE_CSCS_C_EVT_RESUMED);
+        }
+        else
+        {
+            // Try again with the next probe.
+            p_suspend->state = BLE_CSCS_C_SUSPEND_SUSPENDED;
+        }
+        p_suspend->state_time = now;
+    }
+}
+
+/**@brief     Function for passing a CCCD write queued by the application to the auto-suspend policy.
+ *
+ * @details   Notifications turned off by the application stay off: they are not probed until the
+ *            application turns them on again, which restarts the suspend timeout. A pending CCCD
+ *            write of the policy is superseded by the write of the application.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ * @param[in] enable       True if the application turned notifications on.
+ */
+static void suspend_on_app_cccd(ble_cscs_c_t * p_ble_cscs_c, bool enable)
+{
+    ble_cscs_c_suspend_t * p_suspend = &p_ble_cscs_c->suspend;
+    uint32_t               now       = (p_ble_cscs_c->timestamp_get != NULL) ? p_ble_cscs_c->timestamp_get() : 0;
+
+    if (p_suspend->state == BLE_CSCS_C_SUSPEND_SUSPENDED)
+    {
+        p_suspend->stats.suspended_time += now - p_suspend->state_time;
+    }
+
+    p_suspend->state       = enable ? BLE_CSCS_C_SUSPEND_ACTIVE : BLE_CSCS_C_SUSPEND_DISABLED;
+    p_suspend->state_time  = now;
+    p_suspend->change_time = now;
+}
+#endif
+
+/**@brief     Function for handling Handle Value Notification received from the SoftDevice.
+ *
+ * @details   This function uses the Handle Value Notification received from the SoftDevice
+ *            and checks whether it is a notification of the Cycling Speed and Cadence measurement from
+ *            the peer. If it is, this function decodes the Cycling Speed measurement and sends it
+ *            to the application. Measurements that are too short for the layout announced by their
+ *            flags are counted in @ref ble_cscs_c_s::malformed_meas_count and dropped.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ * @param[in] p_ble_evt    Pointer to the BLE event received.
+ */
+static void on_hvx(ble_cscs_c_t * p_ble_cscs_c, const ble_evt_t * p_ble_evt)
+{
+    const ble_gattc_evt_hvx_t * p_notif = &p_ble_evt->evt.gattc_evt.params.hvx;
+
+    // Check if the event is on the link for this instance
+    if (p_ble_cscs_c->conn_handle != p_ble_evt->evt.gattc_evt.conn_handle)
+    {
+        COUNTER_INC(p_ble_cscs_c, wrong_conn_count);
+        return;
+    }
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CAPTURE)
+    if (p_ble_cscs_c->p_capture != NULL)
+    {
+        capture_put(p_ble_cscs_c, &p_ble_evt->evt.gattc_evt);
+    }
+#endif
+
+    if (p_notif->handle != p_ble_cscs_c->peer_db.cscs_handle)
+    {
+        COUNTER_INC(p_ble_cscs_c, wrong_handle_count);
+    }
+    else
+    {
+        ble_cscs_c_evt_t ble_cscs_c_evt;
+
+        COUNTER_INC(p_ble_cscs_c, notif_rx_count);
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_MEAS_VIEW)
+        if (p_ble_cscs_c->meas_view)
+        {
+            ble_cscs_c_evt.evt_type               = BLE_CSCS_C_EVT_CSM_VIEW;
+            ble_cscs_c_evt.conn_handle            = p_ble_evt->evt.gattc_evt.conn_handle;
+            ble_cscs_c_evt.params.csc_view.p_data = p_notif->data;
+            ble_cscs_c_evt.params.csc_view.len    = p_notif->len;
+            evt_handler_call(p_ble_cscs_c, &ble_cscs_c_evt);
+            return;
+        }
+#endif
+
+        if (!csc_meas_decode(p_notif->data,
+                             p_notif->len,
+                             p_ble_cscs_c->meas_flags_mask,
+                             &ble_cscs_c_evt.params.csc))
+        {
+            NRF_LOG_DEBUG("Malformed CSC Measurement, length: %d", p_notif->len);
+            p_ble_cscs_c->malformed_meas_count++;
+            return;
+        }
+
+        COUNTER_INC(p_ble_cscs_c, notif_decoded_count);
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_SUSPEND)
+        if ((p_ble_cscs_c->suspend_timeout != 0) && (p_ble_cscs_c->timestamp_get != NULL))
+        {
+            suspend_on_meas(p_ble_cscs_c, &ble_cscs_c_evt.params.csc);
+        }
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONTINUITY)
+        if (p_ble_cscs_c->is_continuity_pending)
+        {
+            continuity_reconcile(p_ble_cscs_c, &ble_cscs_c_evt.params.csc);
+        }
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CALC)
+        calc_update(p_ble_cscs_c, &ble_cscs_c_evt.params.csc);
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_STATS)
+        if ((p_ble_cscs_c->p_stats != NULL) && (p_ble_cscs_c->timestamp_get != NULL))
+        {
+            ble_cscs_c_stats_update(p_ble_cscs_c->p_stats,
+                                    p_ble_cscs_c->timestamp_get(),
+                                    &ble_cscs_c_evt.params.csc);
+        }
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONN_POLICY)
+        if ((p_ble_cscs_c->p_conn_policy != NULL) && (p_ble_cscs_c->timestamp_get != NULL))
+        {
+            ble_cscs_c_conn_policy_on_meas(p_ble_cscs_c->p_conn_policy,
+                                           p_ble_cscs_c->conn_handle,
+                                           p_ble_cscs_c->timestamp_get(),
+                                           &ble_cscs_c_evt.params.csc);
+        }
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_FILTER)
+        if (!filter_pass(p_ble_cscs_c, &ble_cscs_c_evt.params.csc))
+        {
+            return;
+        }
+#endif
+
+        meas_deliver(p_ble_cscs_c, &ble_cscs_c_evt);
+    }
+}
+
+/**@brief     Function for handling events from the Database Discovery module.
+ *
+ * @details   This function handles an event from the Database Discovery module, and determines
+ *            whether it relates to the discovery of Cycling Speed and Cadence service at the peer. If it does, the function
+ *            calls the application's event handler to indicate that the Cycling Speed and Cadence
+ *            service was discovered at the peer. The function also populates the event with service-related
+ * 			  information before providing it to the application.
+ *
+ * @param[in] p_evt Pointer to the event received from the Database Discovery module.
+ *
+ */
+void ble_cscs_on_db_disc_evt(ble_cscs_c_t * p_ble_cscs_c, const ble_db_discovery_evt_t * p_evt)
+{
+        // Check if the Cycling Speed and Cadence Service was discovered.
+    if (p_evt->evt_type == BLE_DB_DISCOVERY_COMPLETE &&
+        p_evt->params.discovered_db.srv_uuid.uuid == BLE_UUID_CYCLING_SPEED_AND_CADENCE &&
+        p_evt->params.discovered_db.srv_uuid.type == BLE_UUID_TYPE_BLE)
+    {
+        ble_cscs_c_evt_t evt;
+
+        evt.params.cscs_db.cscs_cccd_handle    = BLE_GATT_HANDLE_INVALID;
+        evt.params.cscs_db.cscs_handle         = BLE_GATT_HANDLE_INVALID;
+        evt.params.cscs_db.cscs_feature_handle = BLE_GATT_HANDLE_INVALID;
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+        evt.params.cscs_db.cscs_sensloc_handle = BLE_GATT_HANDLE_INVALID;
+#endif
+
+        for (uint32_t i = 0; i < p_evt->params.discovered_db.char_count; i++)
+        {
+            switch (p_evt->params.discovered_db.charateristics[i].characteristic.uuid.uuid)
+            {
+                case BLE_UUID_CSC_MEASUREMENT_CHAR:
+                {
+                    evt.params.cscs_db.cscs_cccd_handle =
+                        p_evt->params.discovered_db.charateristics[i].cccd_handle;
+                    evt.params.cscs_db.cscs_handle      =
+                        p_evt->params.discovered_db.charateristics[i].characteristic.handle_value;
+                    break;
+                }
+                case BLE_UUID_CSC_FEATURE_CHAR:
+                {
+                    evt.params.cscs_db.cscs_feature_handle =
+                        p_evt->params.discovered_db.charateristics[i].characteristic.handle_value;
+                    break;
+                }
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+                case BLE_UUID_SENSOR_LOCATION_CHAR:
+                {
+                    evt.params.cscs_db.cscs_sensloc_handle =
+                        p_evt->params.discovered_db.charateristics[i].characteristic.handle_value;
+                    break;
+                }
+#endif
+            }
+        }
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DB_CACHE)
+        if ((p_ble_cscs_c->p_db_cache != NULL)          &&
+            (p_ble_cscs_c->is_peer_addr_valid)          &&
+            (p_ble_cscs_c->conn_handle == p_evt->conn_handle))
+        {
+            uint32_t err_code = p_ble_cscs_c->p_db_cache->store(&p_ble_cscs_c->peer_addr,
+                                                                &evt.params.cscs_db);
+            if (err_code != NRF_SUCCESS)
+            {
+                NRF_LOG_DEBUG("Storing discovered handles failed, error: %d", err_code);
+            }
+        }
+#endif
+
+        evt.evt_type = BLE_CSCS_C_EVT_DISCOVERY_COMPLETE;
+        evt.conn_handle = p_evt->conn_handle;
+        evt_handler_call(p_ble_cscs_c, &evt);
+    }
+}
+
+uint32_t ble_cscs_c_init(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_init_t * p_ble_cscs_c_init)
+{
+    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
+    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c_init);
+
+    ble_uuid_t cscs_uuid;
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CALC)
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    if (p_ble_cscs_c_init->wheel_circumference > BLE_CSCS_C_WHEEL_CIRCUMFERENCE_MAX)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    p_ble_cscs_c->wheel_circumference      = p_ble_cscs_c_init->wheel_circumference;
+#endif
+    memset(&p_ble_cscs_c->calc_state, 0, sizeof(p_ble_cscs_c->calc_state));
+#endif
+    cscs_uuid.type = BLE_UUID_TYPE_BLE;
+    cscs_uuid.uuid = BLE_UUID_CYCLING_SPEED_AND_CADENCE;
+
+    p_ble_cscs_c->evt_handler              = p_ble_cscs_c_init->evt_handler;
+    p_ble_cscs_c->error_handler            = p_ble_cscs_c_init->error_handler;
+    p_ble_cscs_c->conn_handle              = BLE_CONN_HANDLE_INVALID;
+    p_ble_cscs_c->peer_db.cscs_cccd_handle = BLE_GATT_HANDLE_INVALID;
+    p_ble_cscs_c->peer_db.cscs_handle      = BLE_GATT_HANDLE_INVALID;
+    p_ble_cscs_c->peer_db.cscs_feature_handle = BLE_GATT_HANDLE_INVALID;
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+    p_ble_cscs_c->peer_db.cscs_sensloc_handle = BLE_GATT_HANDLE_INVALID;
+#endif
+    p_ble_cscs_c->p_gatt_queue             = p_ble_cscs_c_init->p_gatt_queue;
+    p_ble_cscs_c->setup_pending            = 0;
+    p_ble_cscs_c->meas_flags_mask          = CSCM_FLAG_SUPPORTED_MASK;
+    p_ble_cscs_c->malformed_meas_count     = 0;
+    p_ble_cscs_c->timestamp_get            = p_ble_cscs_c_init->timestamp_get;
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_FILTER)
+    p_ble_cscs_c->filter_mode              = p_ble_cscs_c_init->filter_mode;
+    p_ble_cscs_c->filter_interval          = p_ble_cscs_c_init->filter_interval;
+    memset(&p_ble_cscs_c->filter, 0, sizeof(p_ble_cscs_c->filter));
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_MEAS_VIEW)
+    p_ble_cscs_c->meas_view                = p_ble_cscs_c_init->meas_view;
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CAPTURE)
+    p_ble_cscs_c->p_capture                = p_ble_cscs_c_init->p_capture;
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_STATS)
+    p_ble_cscs_c->p_stats                  = p_ble_cscs_c_init->p_stats;
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONN_POLICY)
+    p_ble_cscs_c->p_conn_policy            = p_ble_cscs_c_init->p_conn_policy;
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_SUSPEND)
+    p_ble_cscs_c->suspend_timeout          = p_ble_cscs_c_init->suspend_timeout;
+    p_ble_cscs_c->probe_interval           = p_ble_cscs_c_init->probe_interval;
+    memset(&p_ble_cscs_c->suspend, 0, sizeof(p_ble_cscs_c->suspend));
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONTINUITY)
+    p_ble_cscs_c->p_continuity             = p_ble_cscs_c_init->p_continuity;
+    p_ble_cscs_c->is_continuity_pending    = false;
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_COUNTERS)
+    (void)ble_cscs_c_counters_reset(p_ble_cscs_c);
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DB_CACHE)
+    p_ble_cscs_c->p_db_cache               = p_ble_cscs_c_init->p_db_cache;
+    p_ble_cscs_c->is_peer_addr_valid       = false;
+    p_ble_cscs_c->is_peer_db_cached        = false;
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DEFERRED)
+    p_ble_cscs_c->meas_queue.wr_idx         = 0;
+    p_ble_cscs_c->meas_queue.rd_idx         = 0;
+    p_ble_cscs_c->meas_queue.overflow_count = 0;
+#endif
+
+    return ble_db_discovery_evt_register(&cscs_uuid);
+}
+
+uint32_t ble_cscs_c_handles_assign(ble_cscs_c_t *    p_ble_cscs_c,
+                                   uint16_t          conn_handle,
+                                   ble_cscs_c_db_t * p_peer_handles)
+{
+    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
+    p_ble_cscs_c->conn_handle = conn_handle;
+    if (p_peer_handles != NULL)
+    {
+        p_ble_cscs_c->peer_db = *p_peer_handles;
+    }
+    p_ble_cscs_c->setup_pending   = 0;
+    p_ble_cscs_c->meas_flags_mask = CSCM_FLAG_SUPPORTED_MASK;
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CALC)
+    memset(&p_ble_cscs_c->calc_state, 0, sizeof(p_ble_cscs_c->calc_state));
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_FILTER)
+    p_ble_cscs_c->filter.is_last_valid = false;
+    p_ble_cscs_c->filter.is_pending    = false;
+    p_ble_cscs_c->filter.is_delivered  = false;
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONN_POLICY)
+    if (p_ble_cscs_c->p_conn_policy != NULL)
+    {
+        ble_cscs_c_conn_policy_reset(p_ble_cscs_c->p_conn_policy);
+    }
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_SUSPEND)
+    p_ble_cscs_c->suspend.state         = BLE_CSCS_C_SUSPEND_ACTIVE;
+    p_ble_cscs_c->suspend.is_last_valid = false;
+    p_ble_cscs_c->suspend.state_time    = (p_ble_cscs_c->timestamp_get != NULL) ? p_ble_cscs_c->timestamp_get() : 0;
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONTINUITY)
+    p_ble_cscs_c->is_continuity_pending = (p_ble_cscs_c->p_continuity != NULL)  &&
+                                          (p_ble_cscs_c->timestamp_get != NULL) &&
+                                          p_ble_cscs_c->is_peer_addr_valid;
+#endif
+
+    return nrf_ble_gq_conn_handle_register(p_ble_cscs_c->p_gatt_queue, conn_handle);
+}
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DB_CACHE)
+uint32_t ble_cscs_c_handles_restore(ble_cscs_c_t         * p_ble_cscs_c,
+                                    uint16_t               conn_handle,
+                                    ble_gap_addr_t const * p_peer_addr)
+{
+    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
+    VERIFY_PARAM_NOT_NULL(p_peer_addr);
+
+    ble_cscs_c_db_t peer_db;
+
+    p_ble_cscs_c->conn_handle        = conn_handle;
+    p_ble_cscs_c->peer_addr          = *p_peer_addr;
+    p_ble_cscs_c->is_peer_addr_valid = true;
+    p_ble_cscs_c->is_peer_db_cached  = false;
+
+    if ((p_ble_cscs_c->p_db_cache == NULL) ||
+        (p_ble_cscs_c->p_db_cache->load(p_peer_addr, &peer_db) != NRF_SUCCESS))
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    NRF_LOG_DEBUG("Restored cached handles on conn_handle: 0x%X", conn_handle);
+    p_ble_cscs_c->is_peer_db_cached = true;
+
+    return ble_cscs_c_handles_assign(p_ble_cscs_c, conn_handle, &peer_db);
+}
+
+/**@brief     Function for handling handles restored from the cache that the peer rejected.
+ *
+ * @details   The cache entry is erased and the application is told to run Database Discovery.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the CSC Client structure.
+ */
+static void db_cache_stale(ble_cscs_c_t * p_ble_cscs_c)
+{
+    ble_cscs_c_evt_t evt;
+
+    (void)p_ble_cscs_c->p_db_cache->erase(&p_ble_cscs_c->peer_addr);
+
+    p_ble_cscs_c->is_peer_db_cached           = false;
+    p_ble_cscs_c->setup_pending               = 0;
+    p_ble_cscs_c->peer_db.cscs_cccd_handle    = BLE_GATT_HANDLE_INVALID;
+    p_ble_cscs_c->peer_db.cscs_handle         = BLE_GATT_HANDLE_INVALID;
+    p_ble_cscs_c->peer_db.cscs_feature_handle = BLE_GATT_HANDLE_INVALID;
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+    p_ble_cscs_c->peer_db.cscs_sensloc_handle = BLE_GATT_HANDLE_INVALID;
+#endif
+
+    evt.evt_type    = BLE_CSCS_C_EVT_DB_CACHE_STALE;
+    evt.conn_handle = p_ble_cscs_c->conn_handle;
+    evt_handler_call(p_ble_cscs_c, &evt);
+}
+#endif
+
+/**@brief     Function for completing a step of @ref ble_cscs_c_setup.
+ *
+ * @details   When the last pending step completes, the fields supported by the peer are
+ *            applied to the decoder and @ref BLE_CSCS_C_EVT_READY is sent to the application.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the CSC Client structure.
+ * @param[in] step         Step that completed.
+ */
+static void setup_step_complete(ble_cscs_c_t * p_ble_cscs_c, uint8_t step)
+{
+    p_ble_cscs_c->setup_pending &= ~step;
+
+    if (p_ble_cscs_c->setup_pending != 0)
+    {
+        return;
+    }
+
+    if (p_ble_cscs_c->ready.is_feature_present)
+    {
+        p_ble_cscs_c->meas_flags_mask = 0;
+        if (p_ble_cscs_c->ready.feature & BLE_CSCS_C_FEATURE_WHEEL_REV_BIT)
+        {
+            p_ble_cscs_c->meas_flags_mask |= CSCM_FLAG_WHEEL_PRESENT;
+        }
+        if (p_ble_cscs_c->ready.feature & BLE_CSCS_C_FEATURE_CRANK_REV_BIT)
+        {
+            p_ble_cscs_c->meas_flags_mask |= CSCM_FLAG_CRANK_PRESENT;
+        }
+        p_ble_cscs_c->meas_flags_mask &= CSCM_FLAG_SUPPORTED_MASK;
+    }
+
+    ble_cscs_c_evt_t evt;
+
+    evt.evt_type     = BLE_CSCS_C_EVT_READY;
+    evt.conn_handle  = p_ble_cscs_c->conn_handle;
+    evt.params.ready = p_ble_cscs_c->ready;
+    evt_handler_call(p_ble_cscs_c, &evt);
+}
+
+/**@brief     Function for handling Write Response event received from the SoftDevice.
+ *
+ * @details   Completes the CCCD write step of @ref ble_cscs_c_setup. A failed write to the CCCD on
+ *            handles restored from the cache means the cached handles no longer match the peer's
+ *            database, and a successful write confirms them.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the CSC Client structure.
+ * @param[in] p_ble_evt    Pointer to the BLE event received.
+ */
+static void on_write_rsp(ble_cscs_c_t * p_ble_cscs_c, const ble_evt_t * p_ble_evt)
+{
+    ble_gattc_evt_t const * p_gattc_evt = &p_ble_evt->evt.gattc_evt;
+    bool                    success     = (p_gattc_evt->gatt_status == BLE_GATT_STATUS_SUCCESS);
+    uint16_t                handle      = success ? p_gattc_evt->params.write_rsp.handle
+                                                  : p_gattc_evt->error_handle;
+
+    if ((p_ble_cscs_c->conn_handle != p_gattc_evt->conn_handle) ||
+        (handle != p_ble_cscs_c->peer_db.cscs_cccd_handle))
+    {
+        return;
+    }
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DB_CACHE)
+    if (p_ble_cscs_c->is_peer_db_cached)
+    {
+        if (!success)
+        {
+            NRF_LOG_DEBUG("Cached handles are stale, GATT status: 0x%X", p_gattc_evt->gatt_status);
+            db_cache_stale(p_ble_cscs_c);
+            return;
+        }
+        p_ble_cscs_c->is_peer_db_cached = false;
+    }
+#endif
+
+    if (p_ble_cscs_c->setup_pending & SETUP_CCCD)
+    {
+        p_ble_cscs_c->ready.is_notif_enabled = success;
+        setup_step_complete(p_ble_cscs_c, SETUP_CCCD);
+        return;
+    }
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_SUSPEND)
+    if (p_ble_cscs_c->timestamp_get != NULL)
+    {
+        suspend_on_write_rsp(p_ble_cscs_c, success);
+    }
+#endif
+}
+
+/**@brief     Function for handling Read Response event received from the SoftDevice.
+ *
+ * @details   Completes the CSC Feature and Sensor Location read steps of @ref ble_cscs_c_setup.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the CSC Client structure.
+ * @param[in] p_ble_evt    Pointer to the BLE event received.
+ */
+static void on_read_rsp(ble_cscs_c_t * p_ble_cscs_c, const ble_evt_t * p_ble_evt)
+{
+    ble_gattc_evt_t const          * p_gattc_evt = &p_ble_evt->evt.gattc_evt;
+    ble_gattc_evt_read_rsp_t const * p_read_rsp  = &p_gattc_evt->params.read_rsp;
+    bool                             success     = (p_gattc_evt->gatt_status == BLE_GATT_STATUS_SUCCESS);
+    uint16_t                         handle      = success ? p_read_rsp->handle
+                                                           : p_gattc_evt->error_handle;
+
+    if (p_ble_cscs_c->conn_handle != p_gattc_evt->conn_handle)
+    {
+        return;
+    }
+
+    if ((handle == p_ble_cscs_c->peer_db.cscs_feature_handle) &&
+        (p_ble_cscs_c->setup_pending & SETUP_FEATURE))
+    {
+        if (success && (p_read_rsp->len >= sizeof(uint16_t)))
+        {
+            p_ble_cscs_c->ready.is_feature_present = true;
+            p_ble_cscs_c->ready.feature            = uint16_decode(p_read_rsp->data);
+        }
+        setup_step_complete(p_ble_cscs_c, SETUP_FEATURE);
+    }
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+    else if ((handle == p_ble_cscs_c->peer_db.cscs_sensloc_handle) &&
+             (p_ble_cscs_c->setup_pending & SETUP_SENSLOC))
+    {
+        if (success && (p_read_rsp->len >= sizeof(uint8_t)))
+        {
+            p_ble_cscs_c->ready.is_sensor_location_present = true;
+            p_ble_cscs_c->ready.sensor_location            = p_read_rsp->data[0];
+        }
+        setup_step_complete(p_ble_cscs_c, SETUP_SENSLOC);
+    }
+#endif
+}
+
+/**@brief     Function for handling Disconnected event received from the SoftDevice.
+ *
+ * @details   This function check whether the disconnect event is happening on the link
+ *            associated with the current instance of the module. If the event is happening, the function sets the instance's
+ *            conn_handle to invalid.
+ *
+ * @param[in] p_ble_rscs_c Pointer to the RSC Client structure.
+ * @param[in] p_ble_evt   Pointer to the BLE event received.
+ */
+static void on_disconnected(ble_cscs_c_t * p_ble_cscs_c, const ble_evt_t * p_ble_evt)
+{
+    if (p_ble_cscs_c->conn_handle == p_ble_evt->evt.gap_evt.conn_handle)
+    {
+        p_ble_cscs_c->conn_handle              = BLE_CONN_HANDLE_INVALID;
+        p_ble_cscs_c->peer_db.cscs_cccd_handle = BLE_GATT_HANDLE_INVALID;
+        p_ble_cscs_c->peer_db.cscs_handle      = BLE_GATT_HANDLE_INVALID;
+        p_ble_cscs_c->peer_db.cscs_feature_handle = BLE_GATT_HANDLE_INVALID;
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+        p_ble_cscs_c->peer_db.cscs_sensloc_handle = BLE_GATT_HANDLE_INVALID;
+#endif
+        p_ble_cscs_c->setup_pending            = 0;
+        p_ble_cscs_c->meas_flags_mask          = CSCM_FLAG_SUPPORTED_MASK;
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONTINUITY)
+        // A link that carried no measurement leaves the stored state of the peer as it was.
+        if (p_ble_cscs_c->is_peer_addr_valid && !p_ble_cscs_c->is_continuity_pending &&
+            (p_ble_cscs_c->p_continuity != NULL) && (p_ble_cscs_c->timestamp_get != NULL))
+        {
+            ble_cscs_c_continuity_store(p_ble_cscs_c->p_continuity,
+                                        &p_ble_cscs_c->peer_addr,
+                                        p_ble_cscs_c->timestamp_get(),
+                                        &p_ble_cscs_c->calc_state);
+        }
+        p_ble_cscs_c->is_continuity_pending    = false;
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DB_CACHE)
+        p_ble_cscs_c->is_peer_addr_valid       = false;
+        p_ble_cscs_c->is_peer_db_cached        = false;
+#endif
+    }
+}
+
+void ble_cscs_c_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context)
+{
+    if ((p_context == NULL) || (p_ble_evt == NULL))
+    {
+        return;
+    }
+
+    ble_cscs_c_t * p_ble_cscs_c = (ble_cscs_c_t *)p_context;
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GATTC_EVT_HVX:
+            on_hvx(p_ble_cscs_c, p_ble_evt);
+            break;
+        case BLE_GAP_EVT_DISCONNECTED:
+            on_disconnected(p_ble_cscs_c, p_ble_evt);
+            break;
+        case BLE_GATTC_EVT_WRITE_RSP:
+            on_write_rsp(p_ble_cscs_c, p_ble_evt);
+            break;
+        case BLE_GATTC_EVT_READ_RSP:
+            on_read_rsp(p_ble_cscs_c, p_ble_evt);
+            break;
+        default:
+            break;
+    }
+}
+
+/**@brief     Function for finding the instance that owns a connection handle.
+ *
+ * @param[in] p_dispatch  Pointer to the dispatcher.
+ * @param[in] conn_handle Connection handle of the event.
+ *
+ * @return    Pointer to the owning instance, or NULL if no instance owns the link.
+ */
+static ble_cscs_c_t * dispatch_instance_get(ble_cscs_c_dispatch_t * p_dispatch, uint16_t conn_handle)
+{
+    if (conn_handle == BLE_CONN_HANDLE_INVALID)
+    {
+        return NULL;
+    }
+
+    if (conn_handle < ARRAY_SIZE(p_dispatch->link_lut))
+    {
+        uint8_t idx = p_dispatch->link_lut[conn_handle];
+
+        if ((idx != 0) && (p_dispatch->p_instances[idx - 1].conn_handle == conn_handle))
+        {
+            return &p_dispatch->p_instances[idx - 1];
+        }
+    }
+
+    // The cached entry is missing or stale, find the owner and remember it.
+    for (uint32_t i = 0; i < p_dispatch->count; i++)
+    {
+        if (p_dispatch->p_instances[i].conn_handle == conn_handle)
+        {
+            if (conn_handle < ARRAY_SIZE(p_dispatch->link_lut))
+            {
+                p_dispatch->link_lut[conn_handle] = (uint8_t)(i + 1);
+            }
+            return &p_dispatch->p_instances[i];
+        }
+    }
+
+    return NULL;
+}
+
+void ble_cscs_c_dispatch_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context)
+{
+    if ((p_context == NULL) || (p_ble_evt == NULL))
+    {
+        return;
+    }
+
+    ble_cscs_c_dispatch_t * p_dispatch = (ble_cscs_c_dispatch_t *)p_context;
+    uint16_t                conn_handle;
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GATTC_EVT_HVX:
+        case BLE_GATTC_EVT_WRITE_RSP:
+        case BLE_GATTC_EVT_READ_RSP:
+            conn_handle = p_ble_evt->evt.gattc_evt.conn_handle;
+            break;
+        case BLE_GAP_EVT_DISCONNECTED:
+            conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+            break;
+        default:
+            return;
+    }
+
+    ble_cscs_c_t * p_ble_cscs_c = dispatch_instance_get(p_dispatch, conn_handle);
+
+    if (p_ble_cscs_c != NULL)
+    {
+        ble_cscs_c_on_ble_evt(p_ble_evt, p_ble_cscs_c);
+    }
+}
+
+/**@brief     Function for handling an error of the GATT Queue on a CCCD write.
+ *
+ * @details   No response follows the error, so the CCCD write step of @ref ble_cscs_c_setup
+ *            completes here with notifications off, and a pending write of the auto-suspend
+ *            policy falls back as if the peer had rejected it.
+ */
+static void cccd_error_handler(uint32_t   nrf_error,
+                               void     * p_ctx,
+                               uint16_t   conn_handle)
+{
+    ble_cscs_c_t * p_ble_cscs_c = (ble_cscs_c_t *)p_ctx;
+
+    gatt_error_handler(nrf_error, p_ctx, conn_handle);
+
+    if (p_ble_cscs_c->conn_handle != conn_handle)
+    {
+        return;
+    }
+
+    if (p_ble_cscs_c->setup_pending & SETUP_CCCD)
+    {
+        p_ble_cscs_c->ready.is_notif_enabled = false;
+        setup_step_complete(p_ble_cscs_c, SETUP_CCCD);
+        return;
+    }
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_SUSPEND)
+    if (p_ble_cscs_c->timestamp_get != NULL)
+    {
+        suspend_on_write_rsp(p_ble_cscs_c, false);
+    }
+#endif
+}
+
+/**@brief     Function for handling an error of the GATT Queue on a characteristic read.
+ *
+ * @details   The GATT Queue sends requests in order, so the read that failed is the oldest read
+ *            step of @ref ble_cscs_c_setup still pending. It completes here without a value.
+ */
+static void read_error_handler(uint32_t   nrf_error,
+                               void     * p_ctx,
+                               uint16_t   conn_handle)
+{
+    ble_cscs_c_t * p_ble_cscs_c = (ble_cscs_c_t *)p_ctx;
+
+    gatt_error_handler(nrf_error, p_ctx, conn_handle);
+
+    if (p_ble_cscs_c->conn_handle != conn_handle)
+    {
+        return;
+    }
+
+    if (p_ble_cscs_c->setup_pending & SETUP_FEATURE)
+    {
+        setup_step_complete(p_ble_cscs_c, SETUP_FEATURE);
+    }
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+    else if (p_ble_cscs_c->setup_pending & SETUP_SENSLOC)
+    {
+        setup_step_complete(p_ble_cscs_c, SETUP_SENSLOC);
+    }
+#endif
+}
+
+/**@brief Function for creating a message for writing to the CCCD.
+ */
+static uint32_t cccd_configure(ble_cscs_c_t * p_ble_cscs_c, bool enable)
+{
+    NRF_LOG_DEBUG("Configuring CCCD. CCCD Handle = %d, Connection Handle = %d",
+                  p_ble_cscs_c->peer_db.cscs_cccd_handle,
+                  p_ble_cscs_c->conn_handle);
+
+    uint8_t          cccd[WRITE_MESSAGE_LENGTH];
+    uint16_t         cccd_val = enable ? BLE_GATT_HVX_NOTIFICATION : 0;
+    nrf_ble_gq_req_t cscs_c_req;
+
+    cccd[0] = LSB_16(cccd_val);
+    cccd[1] = MSB_16(cccd_val);
+
+    memset(&cscs_c_req, 0, sizeof(cscs_c_req));
+    cscs_c_req.type                        = NRF_BLE_GQ_REQ_GATTC_WRITE;
+    cscs_c_req.error_handler.cb            = cccd_error_handler;
+    cscs_c_req.error_handler.p_ctx         = p_ble_cscs_c;
+    cscs_c_req.params.gattc_write.handle   = p_ble_cscs_c->peer_db.cscs_cccd_handle;
+    cscs_c_req.params.gattc_write.len      = WRITE_MESSAGE_LENGTH;
+    cscs_c_req.params.gattc_write.p_value  = cccd;
+    cscs_c_req.params.gattc_write.offset   = 0;
+    cscs_c_req.params.gattc_write.write_op = BLE_GATT_OP_WRITE_REQ;
+    cscs_c_req.params.gattc_write.flags    = BLE_GATT_EXEC_WRITE_FLAG_PREPARED_WRITE;
+
+    return nrf_ble_gq_item_add(p_ble_cscs_c->p_gatt_queue, &cscs_c_req, p_ble_cscs_c->conn_handle);
+}
+
+/**@brief Function for queuing a read of a characteristic value.
+ */
+static uint32_t char_read(ble_cscs_c_t * p_ble_cscs_c, uint16_t handle)
+{
+    nrf_ble_gq_req_t cscs_c_req;
+
+    memset(&cscs_c_req, 0, sizeof(cscs_c_req));
+    cscs_c_req.type                     = NRF_BLE_GQ_REQ_GATTC_READ;
+    cscs_c_req.error_handler.cb         = read_error_handler;
+    cscs_c_req.error_handler.p_ctx      = p_ble_cscs_c;
+    cscs_c_req.params.gattc_read.handle = handle;
+    cscs_c_req.params.gattc_read.offset = 0;
+
+    return nrf_ble_gq_item_add(p_ble_cscs_c->p_gatt_queue, &cscs_c_req, p_ble_cscs_c->conn_handle);
+}
+
+uint32_t ble_cscs_c_csm_notif_enable(ble_cscs_c_t * p_ble_cscs_c)
+{
+    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
+
+    if (p_ble_cscs_c->conn_handle == BLE_CONN_HANDLE_INVALID)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_SUSPEND)
+    uint32_t err_code = cccd_configure(p_ble_cscs_c, true);
+
+    VERIFY_SUCCESS(err_code);
+    suspend_on_app_cccd(p_ble_cscs_c, true);
+
+    return NRF_SUCCESS;
+#else
+    return cccd_configure(p_ble_cscs_c, true);
+#endif
+}
+
+uint32_t ble_cscs_c_csm_notif_disable(ble_cscs_c_t * p_ble_cscs_c)
+{
+    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
+
+    if (p_ble_cscs_c->conn_handle == BLE_CONN_HANDLE_INVALID)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_SUSPEND)
+    // Notifications suspended by the policy are already off at the peer.
+    if (p_ble_cscs_c->suspend.state != BLE_CSCS_C_SUSPEND_SUSPENDED)
+    {
+        uint32_t err_code = cccd_configure(p_ble_cscs_c, false);
+
+        VERIFY_SUCCESS(err_code);
+    }
+    suspend_on_app_cccd(p_ble_cscs_c, false);
+
+    return NRF_SUCCESS;
+#else
+    return cccd_configure(p_ble_cscs_c, false);
+#endif
+}
+
+uint32_t ble_cscs_c_setup(ble_cscs_c_t * p_ble_cscs_c)
+{
+    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
+
+    uint32_t err_code;
+
+    if (p_ble_cscs_c->conn_handle == BLE_CONN_HANDLE_INVALID)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if (p_ble_cscs_c->setup_pending != 0)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    memset(&p_ble_cscs_c->ready, 0, sizeof(p_ble_cscs_c->ready));
+
+    // All steps are pending before the first request is queued, so that a request the GATT Queue
+    // fails right away does not complete the setup early.
+    p_ble_cscs_c->setup_pending = SETUP_CCCD;
+    if (p_ble_cscs_c->peer_db.cscs_feature_handle != BLE_GATT_HANDLE_INVALID)
+    {
+        p_ble_cscs_c->setup_pending |= SETUP_FEATURE;
+    }
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+    if (p_ble_cscs_c->peer_db.cscs_sensloc_handle != BLE_GATT_HANDLE_INVALID)
+    {
+        p_ble_cscs_c->setup_pending |= SETUP_SENSLOC;
+    }
+#endif
+
+    err_code = cccd_configure(p_ble_cscs_c, true);
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_SUSPEND)
+    if (err_code == NRF_SUCCESS)
+    {
+        suspend_on_app_cccd(p_ble_cscs_c, true);
+    }
+#endif
+
+    if ((err_code == NRF_SUCCESS) && (p_ble_cscs_c->setup_pending & SETUP_FEATURE))
+    {
+        err_code = char_read(p_ble_cscs_c, p_ble_cscs_c->peer_db.cscs_feature_handle);
+    }
+
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+    if ((err_code == NRF_SUCCESS) && (p_ble_cscs_c->setup_pending & SETUP_SENSLOC))
+    {
+        err_code = char_read(p_ble_cscs_c, p_ble_cscs_c->peer_db.cscs_sensloc_handle);
+    }
+#endif
+
+    if (err_code != NRF_SUCCESS)
+    {
+        // The responses to the requests already queued are ignored, no READY event is sent.
+        p_ble_cscs_c->setup_pending = 0;
+    }
+
+    return err_code;
+}
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DEFERRED)
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_FILTER)
+/**@brief     Function for queuing the measurement held back by the rate limit of the filter once
+ *            the filter interval has passed without a measurement let through.
+ *
+ * @details   The filter state and the write side of the queue belong to the SoftDevice observer,
+ *            which the critical region keeps out while the measurement is moved to the queue.
+ *
+ * @param[in] p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ */
+static void filter_expired_release(ble_cscs_c_t * p_ble_cscs_c)
+{
+    ble_cscs_c_filter_t * p_filter = &p_ble_cscs_c->filter;
+
+    if ((p_ble_cscs_c->filter_interval == 0) || (p_ble_cscs_c->timestamp_get == NULL))
+    {
+        return;
+    }
+
+    uint32_t now = p_ble_cscs_c->timestamp_get();
+
+    CRITICAL_REGION_ENTER();
+    if (p_filter->is_pending && ((now - p_filter->delivered_time) >= p_ble_cscs_c->filter_interval))
+    {
+        p_filter->is_pending     = false;
+        p_filter->delivered_time = now;
+        p_filter->delivered_count++;
+        meas_queue_put(&p_ble_cscs_c->meas_queue, &p_filter->last);
+    }
+    CRITICAL_REGION_EXIT();
+}
+#endif
+
+uint32_t ble_cscs_c_drain(ble_cscs_c_t      * p_ble_cscs_c,
+                          ble_cscs_c_meas_t * p_meas,
+                          uint16_t          * p_count)
+{
+    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
+    VERIFY_PARAM_NOT_NULL(p_meas);
+    VERIFY_PARAM_NOT_NULL(p_count);
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_FILTER)
+    filter_expired_release(p_ble_cscs_c);
+#endif
+
+    ble_cscs_c_meas_queue_t * p_queue = &p_ble_cscs_c->meas_queue;
+    uint32_t                  rd_idx  = p_queue->rd_idx;
+    uint32_t                  count   = MIN(p_queue->wr_idx - rd_idx, *p_count);
+
+    // Read the write index before the measurements it publishes.
+    __DMB();
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        p_meas[i] = p_queue->meas[(rd_idx + i) & (BLE_CSCS_C_DEFERRED_QUEUE_SIZE - 1)];
+    }
+
+    // Finish reading the measurements before releasing their slots.
+    __DMB();
+    p_queue->rd_idx = rd_idx + count;
+
+    *p_count = (uint16_t)count;
+
+    return NRF_SUCCESS;
+}
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CAPTURE)
+uint32_t ble_cscs_c_capture_read(ble_cscs_c_capture_t * p_capture, uint8_t * p_data, uint32_t * p_len)
+{
+    VERIFY_PARAM_NOT_NULL(p_capture);
+    VERIFY_PARAM_NOT_NULL(p_data);
+    VERIFY_PARAM_NOT_NULL(p_len);
+
+    uint32_t rd_idx = p_capture->rd_idx;
+    uint32_t len    = MIN(p_capture->wr_idx - rd_idx, *p_len);
+    uint32_t offset = rd_idx & (p_capture->size - 1);
+    uint32_t first  = MIN(len, p_capture->size - offset);
+
+    // Read the write index before the records it publishes.
+    __DMB();
+
+    memcpy(p_data, &p_capture->p_data[offset], first);
+    memcpy(&p_data[first], p_capture->p_data, len - first);
+
+    // Finish reading the records before releasing their space.
+    __DMB();
+    p_capture->rd_idx = rd_idx + len;
+
+    *p_len = len;
+
+    return NRF_SUCCESS;
+}
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_MEAS_VIEW)
+/**@brief     Function for looking up the layout of an undecoded measurement.
+ *
+ * @param[in]  p_view   Undecoded measurement.
+ * @param[out] pp_layout Layout given by the flags of the measurement.
+ *
+ * @retval     NRF_SUCCESS              If the payload is long enough for its layout.
+ * @retval     NRF_ERROR_INVALID_LENGTH Otherwise.
+ */
+static uint32_t meas_view_layout_get(ble_cscs_c_meas_view_t const * p_view,
+                                     cscm_layout_t const         ** pp_layout)
+{
+    if (p_view->len < CSCM_FLAGS_LEN)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    *pp_layout = &m_cscm_layouts[p_view->p_data[0] & CSCM_FLAG_LAYOUT_MASK];
+
+    return (p_view->len < (*pp_layout)->len) ? NRF_ERROR_INVALID_LENGTH : NRF_SUCCESS;
+}
+
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+uint32_t ble_cscs_c_meas_view_wheel_get(ble_cscs_c_meas_view_t const * p_view,
+                                        uint32_t                     * p_cumulative_wheel_revs,
+                                        uint16_t                     * p_last_wheel_event_time)
+{
+    VERIFY_PARAM_NOT_NULL(p_view);
+    VERIFY_PARAM_NOT_NULL(p_cumulative_wheel_revs);
+    VERIFY_PARAM_NOT_NULL(p_last_wheel_event_time);
+
+    cscm_layout_t const * p_layout;
+    uint32_t              err_code = meas_view_layout_get(p_view, &p_layout);
+
+    VERIFY_SUCCESS(err_code);
+
+    if (!(p_view->p_data[0] & CSCM_FLAG_WHEEL_PRESENT))
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    *p_cumulative_wheel_revs = uint32_decode(&p_view->p_data[p_layout->wheel_offset]);
+    *p_last_wheel_event_time = uint16_decode(&p_view->p_data[p_layout->wheel_offset + sizeof(uint32_t)]);
+
+    return NRF_SUCCESS;
+}
+#endif
+
+#if BLE_CSCS_C_CRANK_SUPPORTED
+uint32_t ble_cscs_c_meas_view_crank_get(ble_cscs_c_meas_view_t const * p_view,
+                                        uint16_t                     * p_cumulative_crank_revs,
+                                        uint16_t                     * p_last_crank_event_time)
+{
+    VERIFY_PARAM_NOT_NULL(p_view);
+    VERIFY_PARAM_NOT_NULL(p_cumulative_crank_revs);
+    VERIFY_PARAM_NOT_NULL(p_last_crank_event_time);
+
+    cscm_layout_t const * p_layout;
+    uint32_t              err_code = meas_view_layout_get(p_view, &p_layout);
+
+    VERIFY_SUCCESS(err_code);
+
+    if (!(p_view->p_data[0] & CSCM_FLAG_CRANK_PRESENT))
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    *p_cumulative_crank_revs = uint16_decode(&p_view->p_data[p_layout->crank_offset]);
+    *p_last_crank_event_time = uint16_decode(&p_view->p_data[p_layout->crank_offset + sizeof(uint16_t)]);
+
+    return NRF_SUCCESS;
+}
+#endif
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_FILTER)
+uint32_t ble_cscs_c_filter_flush(ble_cscs_c_t * p_ble_cscs_c)
+{
+    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DEFERRED)
+    // The queue has a single producer, the SoftDevice observer, which also owns the filter state.
+    // ble_cscs_c_drain releases the held measurement instead.
+    return NRF_ERROR_INVALID_STATE;
+#else
+    ble_cscs_c_filter_t * p_filter = &p_ble_cscs_c->filter;
+    ble_cscs_c_evt_t      evt;
+
+    if (!p_filter->is_pending)
+    {
+        return NRF_SUCCESS;
+    }
+
+    p_filter->is_pending = false;
+    p_filter->delivered_count++;
+
+    if (p_ble_cscs_c->timestamp_get != NULL)
+    {
+        p_filter->delivered_time = p_ble_cscs_c->timestamp_get();
+    }
+
+    evt.params.csc = p_filter->last;
+    meas_deliver(p_ble_cscs_c, &evt);
+
+    return NRF_SUCCESS;
+#endif
+}
+
+uint32_t ble_cscs_c_filter_stats_get(ble_cscs_c_t const         * p_ble_cscs_c,
+                                     ble_cscs_c_filter_stats_t  * p_stats)
+{
+    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
+    VERIFY_PARAM_NOT_NULL(p_stats);
+
+    p_stats->rx_count            = p_ble_cscs_c->filter.rx_count;
+    p_stats->delivered_count     = p_ble_cscs_c->filter.delivered_count;
+    p_stats->suppressed_permille = 0;
+
+    if (p_stats->rx_count != 0)
+    {
+        p_stats->suppressed_permille =
+            (uint16_t)((uint64_t)(p_stats->rx_count - p_stats->delivered_count) * 1000 / p_stats->rx_count);
+    }
+
+    return NRF_SUCCESS;
+}
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_SUSPEND)
+uint32_t ble_cscs_c_resume(ble_cscs_c_t * p_ble_cscs_c)
+{
+    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
+
+    ble_cscs_c_suspend_t * p_suspend = &p_ble_cscs_c->suspend;
+    uint32_t               now       = (p_ble_cscs_c->timestamp_get != NULL) ? p_ble_cscs_c->timestamp_get() : 0;
+
+    if (p_ble_cscs_c->conn_handle == BLE_CONN_HANDLE_INVALID)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if (p_suspend->state == BLE_CSCS_C_SUSPEND_SUSPENDING)
+    {
+        return NRF_ERROR_BUSY;
+    }
+    if (p_suspend->state == BLE_CSCS_C_SUSPEND_DISABLED)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    p_suspend->change_time = now;
+
+    if (p_suspend->state != BLE_CSCS_C_SUSPEND_SUSPENDED)
+    {
+        return NRF_SUCCESS;
+    }
+
+    return resume_start(p_ble_cscs_c, now);
+}
+
+void ble_cscs_c_suspend_process(ble_cscs_c_t * p_ble_cscs_c)
+{
+    if ((p_ble_cscs_c == NULL)                                 ||
+        (p_ble_cscs_c->conn_handle == BLE_CONN_HANDLE_INVALID) ||
+        (p_ble_cscs_c->suspend_timeout == 0)                   ||
+        (p_ble_cscs_c->timestamp_get == NULL))
+    {
+        return;
+    }
+
+    ble_cscs_c_suspend_t * p_suspend = &p_ble_cscs_c->suspend;
+    uint32_t               now       = p_ble_cscs_c->timestamp_get();
+
+    if (p_suspend->state == BLE_CSCS_C_SUSPEND_SUSPENDED)
+    {
+        if ((p_ble_cscs_c->probe_interval != 0) &&
+            ((now - p_suspend->state_time) >= p_ble_cscs_c->probe_interval) &&
+            (resume_start(p_ble_cscs_c, now) == NRF_SUCCESS))
+        {
+            p_suspend->stats.probe_count++;
+        }
+    }
+    else if ((p_suspend->state == BLE_CSCS_C_SUSPEND_ACTIVE)                      &&
+             p_suspend->is_last_valid                                              &&
+             ((now - p_suspend->change_time) >= p_ble_cscs_c->suspend_timeout) &&
+             ((now - p_suspend->state_time)  >= p_ble_cscs_c->suspend_timeout))
+    {
+        // The sensor stopped notifying, or a probe got no answer.
+        suspend_start(p_ble_cscs_c, now);
+    }
+}
+
+uint32_t ble_cscs_c_suspend_stats_get(ble_cscs_c_t const         * p_ble_cscs_c,
+                                      ble_cscs_c_suspend_stats_t * p_stats)
+{
+    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
+    VERIFY_PARAM_NOT_NULL(p_stats);
+
+    ble_cscs_c_suspend_t const * p_suspend = &p_ble_cscs_c->suspend;
+
+    *p_stats = p_suspend->stats;
+
+    if ((p_suspend->state == BLE_CSCS_C_SUSPEND_SUSPENDED) && (p_ble_cscs_c->timestamp_get != NULL))
+    {
+        p_stats->suspended_time += p_ble_cscs_c->timestamp_get() - p_suspend->state_time;
+    }
+
+    p_stats->notif_saved_count = (p_suspend->notif_interval != 0)
+                                 ? (p_stats->suspended_time / p_suspend->notif_interval)
+                                 : 0;
+
+    return NRF_SUCCESS;
+}
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_COUNTERS)
+uint32_t ble_cscs_c_counters_get(ble_cscs_c_t const * p_ble_cscs_c, ble_cscs_c_counters_t * p_counters)
+{
+    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
+    VERIFY_PARAM_NOT_NULL(p_counters);
+
+    *p_counters                 = p_ble_cscs_c->counters;
+    p_counters->malformed_count = p_ble_cscs_c->malformed_meas_count;
+
+    if (p_counters->handler_call_count != 0)
+    {
+        p_counters->handler_cycles_avg = (uint32_t)(p_counters->handler_cycles_sum /
+                                                    p_counters->handler_call_count);
+    }
+    else
+    {
+        p_counters->handler_cycles_min = 0;
+    }
+
+    return NRF_SUCCESS;
+}
+
+uint32_t ble_cscs_c_counters_reset(ble_cscs_c_t * p_ble_cscs_c)
+{
+    VERIFY_PARAM_NOT_NULL(p_ble_cscs_c);
+
+    memset(&p_ble_cscs_c->counters, 0, sizeof(p_ble_cscs_c->counters));
+    p_ble_cscs_c->counters.handler_cycles_min = UINT32_MAX;
+    p_ble_cscs_c->malformed_meas_count        = 0;
+
+    return NRF_SUCCESS;
+}
+#endif
 
 /** @}
  *  @endcond
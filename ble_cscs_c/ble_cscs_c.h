@@ -43,6 +43,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "sdk_common.h"
 #include "ble.h"
 #include "ble_db_discovery.h"
 #include "ble_srv_common.h"
@@ -53,6 +54,31 @@
 extern "C" {
 #endif
 
+#ifndef BLE_CSCS_C_WHEEL_SUPPORTED
+#define BLE_CSCS_C_WHEEL_SUPPORTED  1   /**< Set to 0 in sdk_config.h to remove support for Wheel Revolution Data. */
+#endif
+#ifndef BLE_CSCS_C_CRANK_SUPPORTED
+#define BLE_CSCS_C_CRANK_SUPPORTED  1   /**< Set to 0 in sdk_config.h to remove support for Crank Revolution Data. */
+#endif
+#ifndef BLE_CSCS_C_SENSLOC_SUPPORTED
+#define BLE_CSCS_C_SENSLOC_SUPPORTED 1  /**< Set to 0 in sdk_config.h to remove support for the Sensor Location characteristic. */
+#endif
+
+#if !BLE_CSCS_C_WHEEL_SUPPORTED && !BLE_CSCS_C_CRANK_SUPPORTED
+#error "At least one of BLE_CSCS_C_WHEEL_SUPPORTED and BLE_CSCS_C_CRANK_SUPPORTED must be set."
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONTINUITY) && \
+    (!NRF_MODULE_ENABLED(BLE_CSCS_C_CALC) || !NRF_MODULE_ENABLED(BLE_CSCS_C_DB_CACHE))
+#error "BLE_CSCS_C_CONTINUITY requires BLE_CSCS_C_CALC and BLE_CSCS_C_DB_CACHE."
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_STATS) && !NRF_MODULE_ENABLED(BLE_CSCS_C_CALC)
+#error "BLE_CSCS_C_STATS requires BLE_CSCS_C_CALC."
+#endif
+
+#define BLE_CSCS_C_WHEEL_CIRCUMFERENCE_MAX  4095  /**< Largest supported wheel circumference in mm. */
+
 /**@brief   Macro for defining a ble_�scs_c instance.
  *
  * @param   _name   Name of the instance.
@@ -76,33 +102,339 @@ NRF_SDH_BLE_OBSERVERS(_name ## _obs,                      \
                       BLE_CSCS_C_BLE_OBSERVER_PRIO,       \
                       ble_cscs_c_on_ble_evt, &_name, _cnt)
 
+/** @brief Macro for defining multiple ble_cscs_c instances served by a single observer.
+ *
+ * @details Unlike @ref BLE_CSCS_C_ARRAY_DEF, which registers one observer per instance, this macro
+ *          registers one observer for the whole array. Events are routed to the instance that owns
+ *          their connection handle through a lookup table, so the cost per event does not grow
+ *          with the number of instances.
+ *
+ * @param   _name   Name of the array of instances.
+ * @param   _cnt    Number of instances to define.
+ * @hideinitializer
+ */
+#define BLE_CSCS_C_ARRAY_DISPATCH_DEF(_name, _cnt)        \
+static ble_cscs_c_t _name[_cnt];                          \
+static ble_cscs_c_dispatch_t _name ## _dispatch =         \
+{                                                         \
+    .p_instances = _name,                                 \
+    .count       = _cnt                                   \
+};                                                        \
+NRF_SDH_BLE_OBSERVER(_name ## _obs,                       \
+                     BLE_CSCS_C_BLE_OBSERVER_PRIO,        \
+                     ble_cscs_c_dispatch_on_ble_evt,      \
+                     &_name ## _dispatch)
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CAPTURE)
+/**@brief   Macro for defining a capture buffer for raw notifications.
+ *
+ * @param   _name   Name of the capture buffer.
+ * @param   _size   Size of the buffer in bytes. Must be a power of two.
+ * @hideinitializer
+ */
+#define BLE_CSCS_C_CAPTURE_DEF(_name, _size)                                                        \
+STATIC_ASSERT(IS_POWER_OF_TWO(_size), "Capture buffer size must be a power of two.");              \
+static uint8_t CONCAT_2(_name, _data)[_size];                                                       \
+static ble_cscs_c_capture_t _name =                                                                 \
+{                                                                                                   \
+    .p_data = CONCAT_2(_name, _data),                                                               \
+    .size   = _size                                                                                 \
+}
+
+#define BLE_CSCS_C_CAPTURE_HEADER_LEN  9  /**< Length of the header of a capture record. */
+#endif
+
 /**@brief   Structure containing the handles related to the Cycling Speed and Cadence Service found on the peer. */
 typedef struct
 {
     uint16_t cscs_cccd_handle;                /**< Handle of the CCCD of the Cycling Speed and Cadence characteristic. */
     uint16_t cscs_handle;                     /**< Handle of the Cycling Speed and Cadence characteristic as provided by the SoftDevice. */
     uint16_t cscs_feature_handle;             /**< Handle of the Cycling Speed and Cadence feature characteristic as provided by the SoftDevice. */
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
     uint16_t cscs_sensloc_handle;             /**< Handle of the Cycling Speed and Cadence sensor loacation characteristic as provided by the SoftDevice. */
+#endif
 } ble_cscs_c_db_t;
 
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DB_CACHE)
+/**@brief   Storage backend of the discovered handle cache.
+ *
+ * @details Entries are keyed by the peer address passed to @ref ble_cscs_c_handles_restore.
+ *          For bonded peers using privacy, this must be the identity address.
+ */
+typedef struct
+{
+    /**@brief Load the handles stored for a peer. Return NRF_SUCCESS, or NRF_ERROR_NOT_FOUND if there are none. */
+    uint32_t (* load)(ble_gap_addr_t const * p_peer_addr, ble_cscs_c_db_t * p_peer_db);
+    /**@brief Store the handles discovered on a peer, replacing any stored before. */
+    uint32_t (* store)(ble_gap_addr_t const * p_peer_addr, ble_cscs_c_db_t const * p_peer_db);
+    /**@brief Erase the handles stored for a peer. */
+    uint32_t (* erase)(ble_gap_addr_t const * p_peer_addr);
+} ble_cscs_c_db_cache_t;
+#endif
+
 /**@brief   CSCS Client event type. */
 typedef enum
 {
     BLE_CSCS_C_EVT_DISCOVERY_COMPLETE = 1,  /**< Event indicating that the Cycling Speed and Cadence Service has been discovered at the peer. */
-    BLE_CSCS_C_EVT_CSM_NOTIFICATION         /**< Event indicating that a notification of the Cycling Speed and Cadence Measurement characteristic has been received from the peer. */
+    BLE_CSCS_C_EVT_CSM_NOTIFICATION,        /**< Event indicating that a notification of the Cycling Speed and Cadence Measurement characteristic has been received from the peer. */
+    BLE_CSCS_C_EVT_DB_CACHE_STALE,          /**< Event indicating that the handles restored from the cache were rejected by the peer. The application must start Database Discovery. */
+    BLE_CSCS_C_EVT_CSM_VIEW,                /**< Event indicating that a notification of the Cycling Speed and Cadence Measurement characteristic has been received, in place of @ref BLE_CSCS_C_EVT_CSM_NOTIFICATION when @ref ble_cscs_c_init_t::meas_view is set. */
+    BLE_CSCS_C_EVT_READY,                   /**< Event indicating that all requests queued by @ref ble_cscs_c_setup have completed. */
+    BLE_CSCS_C_EVT_SUSPENDED,               /**< Event indicating that notifications were turned off because the counters did not change for @ref ble_cscs_c_init_t::suspend_timeout. */
+    BLE_CSCS_C_EVT_RESUMED,                 /**< Event indicating that notifications were turned back on by @ref ble_cscs_c_resume or a probe. */
+    BLE_CSCS_C_EVT_CONTINUITY               /**< Event indicating how the counters of a reconnected peer were continued. Sent before the first measurement of the link. */
 } ble_cscs_c_evt_type_t;
 
-/**@brief   Structure containing the Running Speed and Cadence measurement received from the peer. */
+#define BLE_CSCS_C_FEATURE_WHEEL_REV_BIT        (0x01 << 0)     /**< CSC Feature bit indicating that Wheel Revolution Data is supported. */
+#define BLE_CSCS_C_FEATURE_CRANK_REV_BIT        (0x01 << 1)     /**< CSC Feature bit indicating that Crank Revolution Data is supported. */
+#define BLE_CSCS_C_FEATURE_MULTIPLE_SENSORS_BIT (0x01 << 2)     /**< CSC Feature bit indicating that multiple sensor locations are supported. */
+
+/**@brief   Structure containing the results of @ref ble_cscs_c_setup. */
+typedef struct
+{
+    bool        is_notif_enabled;           /**< True if notifications of the Cycling Speed and Cadence Measurement were enabled. */
+    bool        is_feature_present;         /**< True if @p feature was read from the peer. */
+    uint16_t    feature;                    /**< CSC Feature, a combination of BLE_CSCS_C_FEATURE_* bits. */
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+    bool        is_sensor_location_present; /**< True if @p sensor_location was read from the peer. */
+    uint8_t     sensor_location;            /**< Sensor Location. */
+#endif
+} ble_cscs_c_ready_t;
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CALC)
+/**@brief   Structure containing the speed, cadence and distance derived from consecutive measurements.
+ *
+ * @details All values are computed with integer arithmetic only. Speed and distance require a
+ *          wheel circumference to be set in @ref ble_cscs_c_init_t::wheel_circumference.
+ */
+typedef struct
+{
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    bool        is_speed_valid;             /**< True if @p speed and @p distance are valid. */
+#endif
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    bool        is_cadence_valid;           /**< True if @p cadence is valid. */
+    uint16_t    cadence;                    /**< Instantaneous cadence in 1/10 rpm. */
+#endif
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    uint32_t    speed;                      /**< Instantaneous speed in mm/s. */
+    uint32_t    distance;                   /**< Distance travelled since the link was assigned, or since the peer was first seen when continued with @ref ble_cscs_c_init_t::p_continuity, in metres. */
+#endif
+} ble_cscs_c_calc_t;
+
+/**@brief   Structure containing the state kept between measurements to derive @ref ble_cscs_c_calc_t. */
 typedef struct
 {
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    bool        is_wheel_ref_valid;         /**< True if the wheel reference values are set. */
+    uint8_t     wheel_stall_count;          /**< Number of consecutive measurements without a new wheel event. */
+    uint16_t    wheel_event_time;           /**< Last Wheel Event Time at the last wheel event. */
+    uint32_t    wheel_revs;                 /**< Cumulative Wheel Revolutions at the last wheel event. */
+    uint32_t    speed;                      /**< Last computed speed in mm/s. */
+    uint32_t    distance;                   /**< Distance travelled in metres. */
+    uint16_t    distance_rem;               /**< Distance travelled in excess of @p distance, in mm. */
+#endif
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    bool        is_crank_ref_valid;         /**< True if the crank reference values are set. */
+    uint8_t     crank_stall_count;          /**< Number of consecutive measurements without a new crank event. */
+    uint16_t    crank_revs;                 /**< Cumulative Crank Revolutions at the last crank event. */
+    uint16_t    crank_event_time;           /**< Last Crank Event Time at the last crank event. */
+    uint16_t    cadence;                    /**< Last computed cadence in 1/10 rpm. */
+#endif
+} ble_cscs_c_calc_state_t;
+#endif
+
+/**@brief   Structure containing the Running Speed and Cadence measurement received from the peer.
+ *
+ * @details The fields of a kind of revolution data not selected with BLE_CSCS_C_WHEEL_SUPPORTED or
+ *          BLE_CSCS_C_CRANK_SUPPORTED are left out, and that data is skipped when decoding.
+ */
+typedef struct
+{
+#if BLE_CSCS_C_WHEEL_SUPPORTED
     bool        is_wheel_rev_data_present;  /**< True if Wheel Revolution Data is present in the measurement. */
+#endif
+#if BLE_CSCS_C_CRANK_SUPPORTED
     bool        is_crank_rev_data_present;  /**< True if Crank Revolution Data is present in the measurement. */
-    uint32_t    cumulative_wheel_revs;      /**< Cumulative Wheel Revolutions. */
+#endif
+#if BLE_CSCS_C_WHEEL_SUPPORTED
     uint16_t    last_wheel_event_time;      /**< Last Wheel Event Time. */
+    uint32_t    cumulative_wheel_revs;      /**< Cumulative Wheel Revolutions. */
+#endif
+#if BLE_CSCS_C_CRANK_SUPPORTED
     uint16_t    cumulative_crank_revs;      /**< Cumulative Crank Revolutions. */
     uint16_t    last_crank_event_time;      /**< Last Crank Event Time. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CALC)
+    ble_cscs_c_calc_t calc;                 /**< Speed, cadence and distance derived from this and the previous measurements. */
+#endif
 } ble_cscs_c_meas_t;
 
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DEFERRED)
+/**@brief   Single-producer/single-consumer queue of measurements waiting for @ref ble_cscs_c_drain.
+ *
+ * @details The SoftDevice observer is the only writer of @p wr_idx and @p overflow_count, and the
+ *          caller of @ref ble_cscs_c_drain is the only writer of @p rd_idx, so no critical region
+ *          is needed. Both indexes run freely and are masked with the queue size on access. The
+ *          one exception is a measurement held back by the filter, which @ref ble_cscs_c_drain
+ *          queues in a critical region.
+ */
+typedef struct
+{
+    ble_cscs_c_meas_t meas[BLE_CSCS_C_DEFERRED_QUEUE_SIZE]; /**< Queued measurements. */
+    volatile uint32_t wr_idx;                               /**< Index of the next measurement to be written. */
+    volatile uint32_t rd_idx;                               /**< Index of the next measurement to be drained. */
+    uint32_t          overflow_count;                       /**< Number of measurements dropped because the queue was full. */
+} ble_cscs_c_meas_queue_t;
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_FILTER)
+/**@brief   Measurement filter modes. */
+typedef enum
+{
+    BLE_CSCS_C_FILTER_NONE,         /**< Pass on every measurement. */
+    BLE_CSCS_C_FILTER_DUPLICATES,   /**< Drop measurements identical to the previous one. */
+    BLE_CSCS_C_FILTER_ON_CHANGE     /**< Pass on measurements only when a cumulative value, speed or cadence changed. */
+} ble_cscs_c_filter_mode_t;
+
+/**@brief   State of the measurement filter. */
+typedef struct
+{
+    ble_cscs_c_meas_t last;             /**< Last measurement that passed the change filter. */
+    bool              is_last_valid;    /**< True if @p last is valid. */
+    bool              is_pending;       /**< True if @p last is held back by the rate limit. */
+    bool              is_delivered;     /**< True if @p delivered_time is valid. */
+    uint32_t          delivered_time;   /**< Time stamp of the last measurement passed on, in ms. */
+    uint32_t          rx_count;         /**< Number of measurements received. */
+    uint32_t          delivered_count;  /**< Number of measurements passed on. */
+} ble_cscs_c_filter_t;
+
+/**@brief   Statistics of the measurement filter. */
+typedef struct
+{
+    uint32_t rx_count;              /**< Number of measurements received. */
+    uint32_t delivered_count;       /**< Number of measurements passed to the application. */
+    uint16_t suppressed_permille;   /**< Share of the received measurements that were suppressed, in 1/1000. */
+} ble_cscs_c_filter_stats_t;
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_COUNTERS)
+/**@brief   Performance counters of a CSC client instance.
+ *
+ * @details Read them with @ref ble_cscs_c_counters_get. Handler execution times are measured with
+ *          BLE_CSCS_C_CYCLE_COUNT_GET(), which defaults to the DWT cycle counter and can be defined
+ *          in sdk_config.h to use another time base.
+ */
+typedef struct
+{
+    uint32_t notif_rx_count;        /**< Notifications received on the measurement handle of this link. */
+    uint32_t notif_decoded_count;   /**< Notifications decoded into a measurement. */
+    uint32_t malformed_count;       /**< Notifications dropped as malformed. Filled from @ref ble_cscs_c_s::malformed_meas_count by @ref ble_cscs_c_counters_get. */
+    uint32_t wrong_handle_count;    /**< Notifications on this link for another handle. */
+    uint32_t wrong_conn_count;      /**< Notifications on another link. When each instance has its own observer, this includes the traffic of all other links. */
+    uint32_t gatt_error_count;      /**< GATT queue errors reported to @ref ble_cscs_c_s::error_handler. */
+    uint32_t handler_call_count;    /**< Number of calls to the event handler. */
+    uint32_t handler_cycles_min;    /**< Shortest execution time of the event handler, in cycles. */
+    uint32_t handler_cycles_max;    /**< Longest execution time of the event handler, in cycles. */
+    uint32_t handler_cycles_avg;    /**< Average execution time of the event handler, in cycles. Filled by @ref ble_cscs_c_counters_get. */
+    uint64_t handler_cycles_sum;    /**< Total execution time of the event handler, in cycles. */
+} ble_cscs_c_counters_t;
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_SUSPEND)
+/**@brief   Notification states of the auto-suspend policy. */
+typedef enum
+{
+    BLE_CSCS_C_SUSPEND_ACTIVE,      /**< Notifications are on. */
+    BLE_CSCS_C_SUSPEND_SUSPENDING,  /**< The CCCD write turning notifications off is pending. */
+    BLE_CSCS_C_SUSPEND_SUSPENDED,   /**< Notifications are off. */
+    BLE_CSCS_C_SUSPEND_RESUMING,    /**< The CCCD write turning notifications on is pending. */
+    BLE_CSCS_C_SUSPEND_DISABLED     /**< Notifications were turned off by @ref ble_cscs_c_csm_notif_disable. */
+} ble_cscs_c_suspend_state_t;
+
+/**@brief   Statistics of the auto-suspend policy. */
+typedef struct
+{
+    uint32_t suspend_count;         /**< Number of times notifications were turned off. */
+    uint32_t probe_count;           /**< Number of times notifications were turned on by a probe. */
+    uint32_t cccd_write_count;      /**< Number of CCCD writes queued by the policy. */
+    uint32_t suspended_time;        /**< Total time with notifications off, in ms. */
+    uint32_t notif_saved_count;     /**< Estimated number of notifications not sent while suspended. Filled by @ref ble_cscs_c_suspend_stats_get. */
+} ble_cscs_c_suspend_stats_t;
+
+/**@brief   State of the auto-suspend policy.
+ *
+ * @details In @ref BLE_CSCS_C_SUSPEND_ACTIVE, notifications are turned off once the cumulative
+ *          counters did not change for the suspend timeout. In @ref BLE_CSCS_C_SUSPEND_SUSPENDED,
+ *          @ref ble_cscs_c_suspend_process turns them on again every probe interval. A probe does
+ *          not restart the suspend timeout, so a first measurement with the same counters turns
+ *          notifications off again at once. In @ref BLE_CSCS_C_SUSPEND_DISABLED, the policy neither
+ *          suspends nor probes until @ref ble_cscs_c_csm_notif_enable or @ref ble_cscs_c_setup.
+ *          A CCCD write of the policy that the peer rejects or the GATT Queue fails leaves the
+ *          notifications as they were: a failed suspend goes back to active, a failed probe back
+ *          to suspended.
+ */
+typedef struct
+{
+    ble_cscs_c_suspend_state_t state;           /**< Notification state. */
+    bool                       is_last_valid;   /**< True if the fields below are set. */
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    uint16_t                   crank_revs;      /**< Last Cumulative Crank Revolutions. */
+#endif
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    uint32_t                   wheel_revs;      /**< Last Cumulative Wheel Revolutions. */
+#endif
+    uint32_t                   change_time;     /**< Time of the last counter change or call to @ref ble_cscs_c_resume, in ms. */
+    uint32_t                   state_time;      /**< Time at which @p state was entered, in ms. */
+    uint32_t                   notif_time;      /**< Time of the last measurement, in ms. */
+    uint32_t                   notif_interval;  /**< Average time between measurements, in ms. */
+    ble_cscs_c_suspend_stats_t stats;           /**< Statistics. */
+} ble_cscs_c_suspend_t;
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONTINUITY)
+/**@brief   Outcome of continuing a revolution counter across a disconnection. */
+typedef enum
+{
+    BLE_CSCS_C_CONTINUITY_NONE,     /**< The counter was not present on both links, it starts over. */
+    BLE_CSCS_C_CONTINUITY_RESUMED,  /**< The counter advanced by a plausible amount, the revolutions were credited. */
+    BLE_CSCS_C_CONTINUITY_RESET     /**< The counter went backwards or jumped too far, the sensor was reset. */
+} ble_cscs_c_continuity_result_t;
+
+/**@brief   Structure describing how the counters of a reconnected peer were continued.
+ *
+ * @details After a sensor reset, the revolutions counted by the sensor since the reset are
+ *          credited if they are plausible for the gap.
+ */
+typedef struct
+{
+    uint32_t                       gap_ms;          /**< Time from the disconnection to the first measurement of the new link, in ms. */
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    ble_cscs_c_continuity_result_t wheel_result;    /**< Outcome for the Cumulative Wheel Revolutions. */
+    uint32_t                       wheel_revs;      /**< Wheel revolutions credited to the distance over the gap. */
+#endif
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    ble_cscs_c_continuity_result_t crank_result;    /**< Outcome for the Cumulative Crank Revolutions. */
+    uint16_t                       crank_revs;      /**< Crank revolutions over the gap. */
+#endif
+} ble_cscs_c_continuity_info_t;
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_MEAS_VIEW)
+/**@brief   Structure referring to an undecoded Cycling Speed and Cadence measurement.
+ *
+ * @details Fields are decoded on demand with @ref ble_cscs_c_meas_view_wheel_get and
+ *          @ref ble_cscs_c_meas_view_crank_get, which check the length of the payload.
+ *          @p p_data points into the SoftDevice event and is only valid during the call to the
+ *          event handler.
+ */
+typedef struct
+{
+    uint8_t const * p_data;     /**< Payload of the notification. */
+    uint16_t        len;        /**< Length of the payload. */
+} ble_cscs_c_meas_view_t;
+#endif
+
 /**@brief   Cycling Speed and Cadence Event structure. */
 typedef struct
 {
@@ -112,12 +444,68 @@ typedef struct
     {
         ble_cscs_c_db_t    cscs_db;           /**< Cycling Speed and Cadence Service related handles found on the peer device. This is filled if the evt_type is @ref BLE_CSCS_C_EVT_DISCOVERY_COMPLETE.*/
         ble_cscs_c_meas_t  csc;               /**< Cycling Speed and Cadence measurement received. This is filled if the evt_type is @ref BLE_CSCS_C_EVT_CSM_NOTIFICATION. */
+        ble_cscs_c_ready_t ready;             /**< Results of @ref ble_cscs_c_setup. This is filled if the evt_type is @ref BLE_CSCS_C_EVT_READY. */
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_MEAS_VIEW)
+        ble_cscs_c_meas_view_t csc_view;      /**< Undecoded Cycling Speed and Cadence measurement received. This is filled if the evt_type is @ref BLE_CSCS_C_EVT_CSM_VIEW. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONTINUITY)
+        ble_cscs_c_continuity_info_t continuity; /**< Continuation of the counters of a reconnected peer. This is filled if the evt_type is @ref BLE_CSCS_C_EVT_CONTINUITY. */
+#endif
     } params;
 } ble_cscs_c_evt_t;
 
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CAPTURE)
+/**@brief   Streaming buffer of raw notifications.
+ *
+ * @details Define it with @ref BLE_CSCS_C_CAPTURE_DEF and read it with @ref ble_cscs_c_capture_read.
+ *          Each notification is stored as one record, all fields little endian:
+ *          | Offset | Size | Field                                      |
+ *          |--------|------|--------------------------------------------|
+ *          | 0      | 1    | Length of the payload                      |
+ *          | 1      | 4    | Time stamp in ms                           |
+ *          | 5      | 2    | Connection handle                          |
+ *          | 7      | 2    | Attribute handle                           |
+ *          | 9      | n    | Payload of the Handle Value Notification   |
+ *
+ *          Records are only written whole; a record that does not fit is dropped and counted.
+ *          The notifications are written from the SoftDevice observer and must be read from a
+ *          single other context.
+ */
+typedef struct
+{
+    uint8_t         * p_data;           /**< Buffer memory. */
+    uint32_t          size;             /**< Size of the buffer in bytes, a power of two. */
+    volatile uint32_t wr_idx;           /**< Index of the next byte to be written. */
+    volatile uint32_t rd_idx;           /**< Index of the next byte to be read. */
+    uint32_t          dropped_count;    /**< Number of records dropped because the buffer was full. */
+} ble_cscs_c_capture_t;
+#endif
+
+/**@brief   Function for getting a time stamp in milliseconds.
+ *
+ * @details Provided by the application, for example from app_timer. Used by the features that
+ *          track time between notifications. The value may wrap around.
+ */
+typedef uint32_t (* ble_cscs_c_timestamp_get_t)(void);
+
 // Forward declaration of the ble_cscs_c_t type.
 typedef struct ble_cscs_c_s ble_cscs_c_t;
 
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_STATS)
+// Forward declaration of the ble_cscs_c_stats_t type, defined in ble_cscs_c_stats.h.
+typedef struct ble_cscs_c_stats_s ble_cscs_c_stats_t;
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONN_POLICY)
+// Forward declaration of the ble_cscs_c_conn_policy_t type, defined in ble_cscs_c_conn_policy.h.
+typedef struct ble_cscs_c_conn_policy_s ble_cscs_c_conn_policy_t;
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONTINUITY)
+// Forward declaration of the ble_cscs_c_continuity_t type, defined in ble_cscs_c_continuity.h.
+typedef struct ble_cscs_c_continuity_s ble_cscs_c_continuity_t;
+#endif
+
 /**@brief   Event handler type.
  *
  * @details This is the type of the event handler that is to be provided by the application
@@ -133,14 +521,107 @@ struct ble_cscs_c_s
     ble_cscs_c_evt_handler_t evt_handler;   /**< Application event handler to be called when there is an event related to the Cunning Speed and Cadence service. */
     ble_srv_error_handler_t  error_handler; /**< Function to be called in case of an error. */
     nrf_ble_gq_t           * p_gatt_queue;  /**< Pointer to BLE GATT Queue instance. */
+    uint32_t                 malformed_meas_count; /**< Number of Cycling Speed and Cadence measurements dropped because they were too short. */
+    ble_cscs_c_timestamp_get_t timestamp_get; /**< Function for getting a time stamp in milliseconds, or NULL. */
+    uint8_t                  setup_pending; /**< Requests queued by @ref ble_cscs_c_setup that have not completed. */
+    uint8_t                  meas_flags_mask; /**< Measurement fields supported by the peer. */
+    ble_cscs_c_ready_t       ready;         /**< Results of @ref ble_cscs_c_setup collected so far. */
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CAPTURE)
+    ble_cscs_c_capture_t   * p_capture;     /**< Buffer to capture raw notifications into, or NULL. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DEFERRED)
+    ble_cscs_c_meas_queue_t  meas_queue;    /**< Measurements waiting to be drained by the application. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_COUNTERS)
+    ble_cscs_c_counters_t    counters;      /**< Performance counters. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_FILTER)
+    ble_cscs_c_filter_mode_t filter_mode;   /**< Filter applied to measurements. */
+    uint16_t                 filter_interval; /**< Shortest time between two measurements passed on, in ms, 0 for no limit. */
+    ble_cscs_c_filter_t      filter;        /**< State of the measurement filter. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DB_CACHE)
+    ble_cscs_c_db_cache_t const * p_db_cache; /**< Storage backend of the discovered handle cache, or NULL. */
+    ble_gap_addr_t           peer_addr;     /**< Address of the peer, valid if @p is_peer_addr_valid is set. */
+    bool                     is_peer_addr_valid; /**< True if @p peer_addr was set by @ref ble_cscs_c_handles_restore. */
+    bool                     is_peer_db_cached;  /**< True if @p peer_db was restored from the cache and not yet confirmed by the peer. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_MEAS_VIEW)
+    bool                     meas_view;     /**< True if measurements are passed undecoded in @ref BLE_CSCS_C_EVT_CSM_VIEW. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CALC)
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    uint16_t                 wheel_circumference; /**< Wheel circumference in mm, 0 if unknown. */
+#endif
+    ble_cscs_c_calc_state_t  calc_state;    /**< State of the speed and cadence calculation. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_STATS)
+    ble_cscs_c_stats_t     * p_stats;       /**< Ride statistics updated with every measurement, or NULL. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONN_POLICY)
+    ble_cscs_c_conn_policy_t * p_conn_policy; /**< Connection parameter policy fed with every measurement, or NULL. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_SUSPEND)
+    uint32_t                 suspend_timeout; /**< Time with unchanged counters after which notifications are turned off, in ms, 0 to disable. */
+    uint32_t                 probe_interval;  /**< Time after which suspended notifications are turned on to probe the sensor, in ms, 0 to disable. */
+    ble_cscs_c_suspend_t     suspend;         /**< State of the auto-suspend policy. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONTINUITY)
+    ble_cscs_c_continuity_t * p_continuity;  /**< Table of peers whose counters are continued, or NULL. */
+    bool                     is_continuity_pending; /**< True until the first measurement of a link to a peer with a known address. */
+#endif
 };
 
+/**@brief   Structure routing BLE events to an array of CSC client instances.
+ *
+ * @details Use @ref BLE_CSCS_C_ARRAY_DISPATCH_DEF to define it. @p link_lut caches, for every
+ *          connection handle, the index of the instance it was last routed to. An entry is
+ *          checked against the instance's connection handle before use and refreshed with a scan
+ *          of the array when it is stale, so assigning and releasing links needs no bookkeeping.
+ */
+typedef struct
+{
+    ble_cscs_c_t * p_instances;                            /**< Array of CSC client instances. */
+    uint8_t        count;                                  /**< Number of instances in @p p_instances. */
+    uint8_t        link_lut[NRF_SDH_BLE_TOTAL_LINK_COUNT]; /**< Index plus one of the instance owning each connection handle, 0 if unknown. */
+} ble_cscs_c_dispatch_t;
+
 /**@brief   Cycling Speed and Cadence client initialization structure. */
 typedef struct
 {
     ble_cscs_c_evt_handler_t evt_handler;   /**< Event handler to be called by the Cycling Speed and Cadence Client module whenever there is an event related to the Cycling Speed and Cadence Service. */
     ble_srv_error_handler_t  error_handler; /**< Function to be called in case of an error. */
     nrf_ble_gq_t           * p_gatt_queue;  /**< Pointer to BLE GATT Queue instance. */
+    ble_cscs_c_timestamp_get_t timestamp_get; /**< Function for getting a time stamp in milliseconds, or NULL. */
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CAPTURE)
+    ble_cscs_c_capture_t   * p_capture;     /**< Buffer to capture raw notifications into, or NULL. A buffer can be shared by several instances. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DB_CACHE)
+    ble_cscs_c_db_cache_t const * p_db_cache; /**< Storage backend of the discovered handle cache, or NULL to disable the cache. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_FILTER)
+    ble_cscs_c_filter_mode_t filter_mode;   /**< Filter applied to measurements before they are passed to the application. */
+    uint16_t                 filter_interval; /**< Shortest time between two measurements passed to the application, in ms, 0 for no limit. Requires @p timestamp_get. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_MEAS_VIEW)
+    bool                     meas_view;     /**< True to receive measurements undecoded in @ref BLE_CSCS_C_EVT_CSM_VIEW. Measurements are then not decoded, derived or queued by this module, so the filter, speed and cadence calculation, ride statistics, connection parameter policy, notification suspend and counter continuity never see one and stay inert. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CALC) && BLE_CSCS_C_WHEEL_SUPPORTED
+    uint16_t                 wheel_circumference; /**< Wheel circumference in mm, at most @ref BLE_CSCS_C_WHEEL_CIRCUMFERENCE_MAX. 0 disables speed and distance. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_STATS)
+    ble_cscs_c_stats_t     * p_stats;       /**< Ride statistics to update with every measurement, or NULL. Initialized with @ref ble_cscs_c_stats_init. Requires @p timestamp_get. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONN_POLICY)
+    ble_cscs_c_conn_policy_t * p_conn_policy; /**< Connection parameter policy to feed with every measurement, or NULL. Initialized with @ref ble_cscs_c_conn_policy_init. Requires @p timestamp_get. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_SUSPEND)
+    uint32_t                 suspend_timeout; /**< Time with unchanged cumulative counters after which notifications are turned off, in ms, 0 to disable. Requires @p timestamp_get. */
+    uint32_t                 probe_interval;  /**< Time after which suspended notifications are turned on again to check for movement, in ms, 0 to only resume with @ref ble_cscs_c_resume. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONTINUITY)
+    ble_cscs_c_continuity_t * p_continuity;  /**< Table of peers whose counters and distance are continued across disconnections, or NULL. Initialized with @ref ble_cscs_c_continuity_init. Peers are identified by the address passed to @ref ble_cscs_c_handles_restore. Requires @p timestamp_get. */
+#endif
 } ble_cscs_c_init_t;
 
 
@@ -156,6 +637,7 @@ typedef struct
  *
  * @retval     NRF_SUCCESS      Operation success.
  * @retval     NRF_ERROR_NULL   A parameter is NULL.
+ * @retval     NRF_ERROR_INVALID_PARAM  The wheel circumference is larger than @ref BLE_CSCS_C_WHEEL_CIRCUMFERENCE_MAX.
  * @retval     err_code       	Otherwise, this function propagates the error code returned by @ref ble_db_discovery_evt_register.
  */
 uint32_t ble_cscs_c_init(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_init_t * p_ble_cscs_c_init);
@@ -170,12 +652,25 @@ uint32_t ble_cscs_c_init(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_init_t * p_ble_
  */
 void ble_cscs_c_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context);
 
+/**@brief   Function for routing the Application's BLE Stack events to an array of instances.
+ *
+ * @details Registered as the observer by @ref BLE_CSCS_C_ARRAY_DISPATCH_DEF. Passes each event
+ *          of interest to @ref ble_cscs_c_on_ble_evt of the instance owning its connection handle.
+ *          Events on links that no instance owns are dropped.
+ *
+ * @param[in]   p_ble_evt   Event received from the BLE stack.
+ * @param[in]   p_context   Pointer to the @ref ble_cscs_c_dispatch_t structure.
+ */
+void ble_cscs_c_dispatch_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context);
+
 /**@brief   Function for requesting the peer to start sending notification of Heart Rate
  *          Measurement.
  *
  * @details This function enables notification of the Cycling Speed and Cadence Measurement at the peer
  *          by writing to the CCCD of the Cycling Speed and Cadence Measurement characteristic.
  *
+ *          With BLE_CSCS_C_SUSPEND, the suspend timeout of the auto-suspend policy starts over.
+ *
  * @param   p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
  *
  * @retval  NRF_SUCCESS If the SoftDevice is requested to write to the CCCD of the peer.
@@ -184,6 +679,49 @@ void ble_cscs_c_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context);
  */
 uint32_t ble_cscs_c_csm_notif_enable(ble_cscs_c_t * p_ble_cscs_c);
 
+/**@brief   Function for requesting the peer to stop sending notifications of the Cycling Speed and
+ *          Cadence Measurement.
+ *
+ * @details This function writes 0 to the CCCD of the Cycling Speed and Cadence Measurement
+ *          characteristic through the GATT Queue.
+ *
+ *          With BLE_CSCS_C_SUSPEND, notifications stay off until @ref ble_cscs_c_csm_notif_enable:
+ *          the auto-suspend policy no longer probes the sensor. No write is queued if the policy
+ *          already suspended notifications.
+ *
+ * @param   p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ *
+ * @retval  NRF_SUCCESS              If the write was queued.
+ * @retval  NRF_ERROR_NULL           If @p p_ble_cscs_c is NULL.
+ * @retval  NRF_ERROR_INVALID_STATE  If no link is assigned to the instance.
+ * @retval  err_code                 Otherwise, this function propagates the error code returned
+ *                                   by @ref nrf_ble_gq_item_add.
+ */
+uint32_t ble_cscs_c_csm_notif_disable(ble_cscs_c_t * p_ble_cscs_c);
+
+/**@brief   Function for enabling notifications and reading the static characteristics in one go.
+ *
+ * @details This function queues the write to the CCCD of the Cycling Speed and Cadence Measurement
+ *          characteristic and the reads of the CSC Feature and Sensor Location characteristics
+ *          on the GATT Queue, so they are sent back to back. When all of them have completed,
+ *          @ref BLE_CSCS_C_EVT_READY is sent to the application with the decoded results.
+ *          From then on, measurement fields that the CSC Feature marks as unsupported are not
+ *          decoded. Characteristics that were not discovered are not read. A request that the
+ *          GATT Queue fails completes like a request that the peer rejects: notifications are
+ *          reported off, or the characteristic not present.
+ *
+ * @param   p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ *
+ * @retval  NRF_SUCCESS              If all requests were queued.
+ * @retval  NRF_ERROR_NULL           If @p p_ble_cscs_c is NULL.
+ * @retval  NRF_ERROR_INVALID_STATE  If no link is assigned to the instance.
+ * @retval  NRF_ERROR_BUSY           If a previous setup has not completed.
+ * @retval  err_code                 Otherwise, this function propagates the error code returned
+ *                                   by @ref nrf_ble_gq_item_add. The setup is abandoned: no
+ *                                   @ref BLE_CSCS_C_EVT_READY follows, and it can be retried.
+ */
+uint32_t ble_cscs_c_setup(ble_cscs_c_t * p_ble_cscs_c);
+
 /**@brief   Function for handling events from the Database Discovery module.
  *
  * @details Call this function when you get a callback event from the Database Discovery module.
@@ -215,6 +753,207 @@ uint32_t ble_cscs_c_handles_assign(ble_cscs_c_t    * p_ble_cscs_c,
                                    uint16_t          conn_handle,
                                    ble_cscs_c_db_t * p_peer_handles);
 
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DB_CACHE)
+/**@brief   Function for assigning a link to this instance using cached handles.
+ *
+ * @details Call this function instead of starting Database Discovery when a link has been
+ *          established. The instance is bound to @p conn_handle and remembers @p p_peer_addr.
+ *          If handles for the peer are found in the cache, they are assigned as with
+ *          @ref ble_cscs_c_handles_assign and notifications can be enabled right away.
+ *          Otherwise, start Database Discovery; the handles it finds are stored in the cache by
+ *          @ref ble_cscs_on_db_disc_evt. If the peer rejects the CCCD write on cached handles,
+ *          the entry is erased and @ref BLE_CSCS_C_EVT_DB_CACHE_STALE is sent to the application.
+ *          With @ref ble_cscs_c_init_t::p_continuity, @p p_peer_addr also selects the counters
+ *          continued on this link.
+ *
+ * @param[in]   p_ble_cscs_c    Pointer to the CSC client structure instance for associating the link.
+ * @param[in]   conn_handle     Connection handle of the link.
+ * @param[in]   p_peer_addr     Address of the peer. For bonded peers, the identity address.
+ *
+ * @retval  NRF_SUCCESS             If cached handles were assigned.
+ * @retval  NRF_ERROR_NOT_FOUND     If the handles of the peer are not cached.
+ * @retval  NRF_ERROR_NULL          If a parameter is NULL.
+ * @retval  err_code                Otherwise, this function propagates the error code returned by
+ *                                  @ref ble_cscs_c_handles_assign.
+ */
+uint32_t ble_cscs_c_handles_restore(ble_cscs_c_t         * p_ble_cscs_c,
+                                    uint16_t               conn_handle,
+                                    ble_gap_addr_t const * p_peer_addr);
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DEFERRED)
+/**@brief   Function for draining measurements queued in deferred delivery mode.
+ *
+ * @details When BLE_CSCS_C_DEFERRED_ENABLED is set, decoded measurements are not passed to the
+ *          event handler from the SoftDevice observer. They are queued in the instance instead,
+ *          and the application fetches them in batches by calling this function from its main
+ *          loop. Measurements that arrive while the queue is full are dropped and counted in
+ *          @ref ble_cscs_c_meas_queue_t::overflow_count.
+ *
+ *          With BLE_CSCS_C_FILTER, a measurement held back by the rate limit for at least
+ *          ble_cscs_c_init_t::filter_interval is queued first, so the last measurement before the
+ *          sensor goes quiet is delivered. This takes a short critical region.
+ *
+ * @note    This function must only be called from one execution context.
+ *
+ * @param[in]     p_ble_cscs_c  Pointer to the CSC client structure instance.
+ * @param[out]    p_meas        Buffer to copy the oldest queued measurements into.
+ * @param[in,out] p_count       In: number of measurements that fit in @p p_meas.
+ *                              Out: number of measurements copied.
+ *
+ * @retval  NRF_SUCCESS     If the queued measurements (possibly none) were copied.
+ * @retval  NRF_ERROR_NULL  If a parameter is NULL.
+ */
+uint32_t ble_cscs_c_drain(ble_cscs_c_t      * p_ble_cscs_c,
+                          ble_cscs_c_meas_t * p_meas,
+                          uint16_t          * p_count);
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CAPTURE)
+/**@brief   Function for reading captured notifications.
+ *
+ * @details Copies the oldest captured bytes and releases them. Records may be split between
+ *          consecutive reads; the length prefix of each record delimits them in the stream.
+ *
+ * @param[in]     p_capture Pointer to the capture buffer.
+ * @param[out]    p_data    Buffer to copy the captured bytes into.
+ * @param[in,out] p_len     In: size of @p p_data. Out: number of bytes copied.
+ *
+ * @retval  NRF_SUCCESS     If the captured bytes (possibly none) were copied.
+ * @retval  NRF_ERROR_NULL  If a parameter is NULL.
+ */
+uint32_t ble_cscs_c_capture_read(ble_cscs_c_capture_t * p_capture, uint8_t * p_data, uint32_t * p_len);
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_MEAS_VIEW)
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+/**@brief   Function for decoding the Wheel Revolution Data of an undecoded measurement.
+ *
+ * @param[in]  p_view                   Undecoded measurement.
+ * @param[out] p_cumulative_wheel_revs  Cumulative Wheel Revolutions.
+ * @param[out] p_last_wheel_event_time  Last Wheel Event Time.
+ *
+ * @retval  NRF_SUCCESS                 If the fields were decoded.
+ * @retval  NRF_ERROR_NOT_FOUND         If the measurement has no Wheel Revolution Data.
+ * @retval  NRF_ERROR_INVALID_LENGTH    If the payload is too short for the layout given by its flags.
+ * @retval  NRF_ERROR_NULL              If a parameter is NULL.
+ */
+uint32_t ble_cscs_c_meas_view_wheel_get(ble_cscs_c_meas_view_t const * p_view,
+                                        uint32_t                     * p_cumulative_wheel_revs,
+                                        uint16_t                     * p_last_wheel_event_time);
+#endif
+
+#if BLE_CSCS_C_CRANK_SUPPORTED
+/**@brief   Function for decoding the Crank Revolution Data of an undecoded measurement.
+ *
+ * @param[in]  p_view                   Undecoded measurement.
+ * @param[out] p_cumulative_crank_revs  Cumulative Crank Revolutions.
+ * @param[out] p_last_crank_event_time  Last Crank Event Time.
+ *
+ * @retval  NRF_SUCCESS                 If the fields were decoded.
+ * @retval  NRF_ERROR_NOT_FOUND         If the measurement has no Crank Revolution Data.
+ * @retval  NRF_ERROR_INVALID_LENGTH    If the payload is too short for the layout given by its flags.
+ * @retval  NRF_ERROR_NULL              If a parameter is NULL.
+ */
+uint32_t ble_cscs_c_meas_view_crank_get(ble_cscs_c_meas_view_t const * p_view,
+                                        uint16_t                     * p_cumulative_crank_revs,
+                                        uint16_t                     * p_last_crank_event_time);
+#endif
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_FILTER)
+/**@brief   Function for passing on a measurement held back by the rate limit of the filter.
+ *
+ * @details Call this function, for example from a timer, when no further notification may arrive
+ *          to release the latest measurement. It must not run concurrently with the SoftDevice
+ *          observer.
+ *
+ *          With BLE_CSCS_C_DEFERRED, the measurement queue and the filter state are written by
+ *          the SoftDevice observer, so this function is refused. A held measurement is then
+ *          superseded by the next measurement let through, or released by @ref ble_cscs_c_drain
+ *          once the filter interval has passed.
+ *
+ * @param[in]  p_ble_cscs_c Pointer to the CSC client structure instance.
+ *
+ * @retval  NRF_SUCCESS             If the held measurement, if any, was passed on.
+ * @retval  NRF_ERROR_INVALID_STATE If BLE_CSCS_C_DEFERRED is enabled.
+ * @retval  NRF_ERROR_NULL          If a parameter is NULL.
+ */
+uint32_t ble_cscs_c_filter_flush(ble_cscs_c_t * p_ble_cscs_c);
+
+/**@brief   Function for reading how many measurements the filter suppressed.
+ *
+ * @param[in]  p_ble_cscs_c Pointer to the CSC client structure instance.
+ * @param[out] p_stats      Statistics of the filter.
+ *
+ * @retval  NRF_SUCCESS     If the statistics were read.
+ * @retval  NRF_ERROR_NULL  If a parameter is NULL.
+ */
+uint32_t ble_cscs_c_filter_stats_get(ble_cscs_c_t const         * p_ble_cscs_c,
+                                     ble_cscs_c_filter_stats_t  * p_stats);
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_SUSPEND)
+/**@brief   Function for turning notifications suspended by the auto-suspend policy back on.
+ *
+ * @details Call it when the application expects the rider to move, for example on a button press.
+ *          The suspend timeout starts over. @ref BLE_CSCS_C_EVT_RESUMED is sent once the peer
+ *          accepted the CCCD write.
+ *
+ * @param   p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ *
+ * @retval  NRF_SUCCESS              If notifications are on or are being turned on.
+ * @retval  NRF_ERROR_NULL           If @p p_ble_cscs_c is NULL.
+ * @retval  NRF_ERROR_INVALID_STATE  If no link is assigned to the instance, or if notifications
+ *                                   were turned off by @ref ble_cscs_c_csm_notif_disable.
+ * @retval  NRF_ERROR_BUSY           If notifications are being turned off. Try again later.
+ * @retval  err_code                 Otherwise, this function propagates the error code returned
+ *                                   by @ref nrf_ble_gq_item_add.
+ */
+uint32_t ble_cscs_c_resume(ble_cscs_c_t * p_ble_cscs_c);
+
+/**@brief   Function for running the time-based steps of the auto-suspend policy.
+ *
+ * @details Call it periodically, for example every second from an app_timer handler. It probes
+ *          the sensor when suspended, and suspends a sensor that stopped notifying.
+ *
+ * @param   p_ble_cscs_c Pointer to the Cycling Speed and Cadence Client structure.
+ */
+void ble_cscs_c_suspend_process(ble_cscs_c_t * p_ble_cscs_c);
+
+/**@brief   Function for reading the statistics of the auto-suspend policy.
+ *
+ * @param[in]  p_ble_cscs_c Pointer to the CSC client structure instance.
+ * @param[out] p_stats      Statistics, including the time of the current suspension.
+ *
+ * @retval  NRF_SUCCESS     If the statistics were read.
+ * @retval  NRF_ERROR_NULL  If a parameter is NULL.
+ */
+uint32_t ble_cscs_c_suspend_stats_get(ble_cscs_c_t const         * p_ble_cscs_c,
+                                      ble_cscs_c_suspend_stats_t * p_stats);
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_COUNTERS)
+/**@brief   Function for taking a snapshot of the performance counters.
+ *
+ * @param[in]  p_ble_cscs_c Pointer to the CSC client structure instance.
+ * @param[out] p_counters   Snapshot of the counters.
+ *
+ * @retval  NRF_SUCCESS     If the snapshot was taken.
+ * @retval  NRF_ERROR_NULL  If a parameter is NULL.
+ */
+uint32_t ble_cscs_c_counters_get(ble_cscs_c_t const * p_ble_cscs_c, ble_cscs_c_counters_t * p_counters);
+
+/**@brief   Function for resetting the performance counters.
+ *
+ * @param[in]  p_ble_cscs_c Pointer to the CSC client structure instance.
+ *
+ * @retval  NRF_SUCCESS     If the counters were reset.
+ * @retval  NRF_ERROR_NULL  If a parameter is NULL.
+ */
+uint32_t ble_cscs_c_counters_reset(ble_cscs_c_t * p_ble_cscs_c);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,178 @@
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONN_POLICY)
+#include "ble_cscs_c_conn_policy.h"
+
+#define NRF_LOG_MODULE_NAME ble_cscs_c_conn_policy
+#include "nrf_log.h"
+NRF_LOG_MODULE_REGISTER();
+
+#define NOTIF_INTERVAL_WEIGHT   8   /**< Weight of the average in the update of the average time between measurements. */
+#define IDLE_NOTIF_INTERVALS    2   /**< Average times between measurements without a new revolution after which the rider may be idle. */
+
+/**@brief     Function for checking whether a measurement has a new revolution.
+ *
+ * @param[in,out] p_policy  Connection policy, its last counters are updated.
+ * @param[in]     p_meas    Measurement.
+ *
+ * @return    True if a revolution counter advanced since the previous measurement.
+ */
+static bool meas_is_moving(ble_cscs_c_conn_policy_t * p_policy, ble_cscs_c_meas_t const * p_meas)
+{
+    bool is_moving = false;
+
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    if (p_meas->is_wheel_rev_data_present)
+    {
+        is_moving            = p_policy->is_last_valid && (p_meas->cumulative_wheel_revs != p_policy->wheel_revs);
+        p_policy->wheel_revs = p_meas->cumulative_wheel_revs;
+    }
+#endif
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    if (p_meas->is_crank_rev_data_present)
+    {
+        is_moving            = is_moving ||
+                               (p_policy->is_last_valid && (p_meas->cumulative_crank_revs != p_policy->crank_revs));
+        p_policy->crank_revs = p_meas->cumulative_crank_revs;
+    }
+#endif
+
+    return is_moving;
+}
+
+/**@brief     Function for requesting the connection parameters of a new activity state.
+ *
+ * @details   The policy switches to @p state only if the request was accepted. Otherwise it stays
+ *            in its state, and the request is repeated as long as the new state still applies.
+ *
+ * @param[in,out] p_policy      Connection policy.
+ * @param[in]     conn_handle   Connection handle of the link.
+ * @param[in]     state         New activity state.
+ */
+static void conn_params_request(ble_cscs_c_conn_policy_t     * p_policy,
+                                uint16_t                       conn_handle,
+                                ble_cscs_c_conn_policy_state_t state)
+{
+    ble_gap_conn_params_t const * p_params = (state == BLE_CSCS_C_CONN_POLICY_IDLE)
+                                             ? &p_policy->config.idle_params
+                                             : &p_policy->config.active_params;
+    uint32_t                      err_code;
+
+    if (p_policy->config.conn_param_update != NULL)
+    {
+        err_code = p_policy->config.conn_param_update(conn_handle, p_params);
+    }
+    else
+    {
+        err_code = sd_ble_gap_conn_param_update(conn_handle, p_params);
+    }
+
+    if (err_code != NRF_SUCCESS)
+    {
+        NRF_LOG_DEBUG("Connection parameter update failed, error: %d", err_code);
+        return;
+    }
+
+    p_policy->state = state;
+    p_policy->update_count++;
+}
+
+uint32_t ble_cscs_c_conn_policy_init(ble_cscs_c_conn_policy_t              * p_policy,
+                                     ble_cscs_c_conn_policy_config_t const * p_config)
+{
+    VERIFY_PARAM_NOT_NULL(p_policy);
+    VERIFY_PARAM_NOT_NULL(p_config);
+
+    if ((p_config->idle_timeout == 0) || (p_config->active_count == 0))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    memset(p_policy, 0, sizeof(*p_policy));
+    p_policy->config = *p_config;
+
+    ble_cscs_c_conn_policy_reset(p_policy);
+
+    return NRF_SUCCESS;
+}
+
+void ble_cscs_c_conn_policy_reset(ble_cscs_c_conn_policy_t * p_policy)
+{
+    p_policy->state          = BLE_CSCS_C_CONN_POLICY_ACTIVE;
+    p_policy->is_last_valid  = false;
+    p_policy->moving_count   = 0;
+    // Until the sensor has shown its rate, assume the slowest one the idle timeout allows for.
+    p_policy->notif_interval = p_policy->config.idle_timeout;
+}
+
+void ble_cscs_c_conn_policy_on_meas(ble_cscs_c_conn_policy_t * p_policy,
+                                    uint16_t                   conn_handle,
+                                    uint32_t                   timestamp,
+                                    ble_cscs_c_meas_t const  * p_meas)
+{
+    bool is_moving = meas_is_moving(p_policy, p_meas);
+
+    if (!p_policy->is_last_valid)
+    {
+        p_policy->is_last_valid = true;
+        p_policy->moving_time   = timestamp;
+        p_policy->notif_time    = timestamp;
+        return;
+    }
+
+    // A sensor silent for longer than the idle timeout does not stretch the timeout further.
+    uint32_t interval = MIN(timestamp - p_policy->notif_time, p_policy->config.idle_timeout);
+
+    p_policy->notif_time     = timestamp;
+    p_policy->notif_interval = (p_policy->notif_interval * (NOTIF_INTERVAL_WEIGHT - 1) + interval) / NOTIF_INTERVAL_WEIGHT;
+
+    if (is_moving)
+    {
+        p_policy->moving_time  = timestamp;
+        p_policy->moving_count = (uint8_t)MIN(p_policy->moving_count + 1, UINT8_MAX);
+    }
+    else
+    {
+        p_policy->moving_count = 0;
+    }
+
+    if ((p_policy->state == BLE_CSCS_C_CONN_POLICY_IDLE) &&
+        (p_policy->moving_count >= p_policy->config.active_count))
+    {
+        NRF_LOG_DEBUG("Rider moving on conn_handle: 0x%X", conn_handle);
+        conn_params_request(p_policy, conn_handle, BLE_CSCS_C_CONN_POLICY_ACTIVE);
+        return;
+    }
+
+    ble_cscs_c_conn_policy_process(p_policy, conn_handle, timestamp);
+}
+
+void ble_cscs_c_conn_policy_process(ble_cscs_c_conn_policy_t * p_policy,
+                                    uint16_t                   conn_handle,
+                                    uint32_t                   timestamp)
+{
+    if ((p_policy == NULL) || !p_policy->is_last_valid || (conn_handle == BLE_CONN_HANDLE_INVALID))
+    {
+        return;
+    }
+
+    // A sensor notifying less often than the idle timeout is not taken for an idle rider between
+    // two measurements.
+    uint32_t idle_timeout = MAX(p_policy->config.idle_timeout, IDLE_NOTIF_INTERVALS * p_policy->notif_interval);
+
+    if ((p_policy->state == BLE_CSCS_C_CONN_POLICY_ACTIVE) &&
+        ((timestamp - p_policy->moving_time) >= idle_timeout))
+    {
+        NRF_LOG_DEBUG("Rider idle on conn_handle: 0x%X", conn_handle);
+        // Revolutions from before the stop do not count towards moving again.
+        p_policy->moving_count = 0;
+        conn_params_request(p_policy, conn_handle, BLE_CSCS_C_CONN_POLICY_IDLE);
+    }
+    else if ((p_policy->state == BLE_CSCS_C_CONN_POLICY_IDLE) &&
+             (p_policy->moving_count >= p_policy->config.active_count))
+    {
+        // The request made with the last measurement failed.
+        conn_params_request(p_policy, conn_handle, BLE_CSCS_C_CONN_POLICY_ACTIVE);
+    }
+}
+
+#endif // NRF_MODULE_ENABLED(BLE_CSCS_C_CONN_POLICY)
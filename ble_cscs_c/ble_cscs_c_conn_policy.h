@@ -0,0 +1,122 @@
+#ifndef BLE_CSCS_C_CONN_POLICY_H__
+#define BLE_CSCS_C_CONN_POLICY_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble_gap.h"
+#include "ble_cscs_c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief   GAP backend requesting new connection parameters.
+ *
+ * @details Has the signature of @ref sd_ble_gap_conn_param_update, which is used when none is
+ *          given. On any error the policy keeps its activity state, and the request is repeated
+ *          with the next measurement or call of @ref ble_cscs_c_conn_policy_process for as long
+ *          as the new state applies.
+ */
+typedef uint32_t (* ble_cscs_c_conn_policy_update_t)(uint16_t conn_handle, ble_gap_conn_params_t const * p_conn_params);
+
+/**@brief   Activity states of the connection policy. */
+typedef enum
+{
+    BLE_CSCS_C_CONN_POLICY_ACTIVE,  /**< The rider is moving, the active connection parameters apply. */
+    BLE_CSCS_C_CONN_POLICY_IDLE     /**< The rider stopped, the idle connection parameters apply. */
+} ble_cscs_c_conn_policy_state_t;
+
+/**@brief   Connection policy configuration. */
+typedef struct
+{
+    ble_gap_conn_params_t           active_params;  /**< Connection parameters while the rider is moving. */
+    ble_gap_conn_params_t           idle_params;    /**< Connection parameters while the rider is idle. */
+    uint32_t                        idle_timeout;   /**< Time without a new revolution after which the rider is idle, in ms. Stretched up to twice this value for sensors notifying less often, see @ref ble_cscs_c_conn_policy_s. */
+    uint8_t                         active_count;   /**< Number of consecutive measurements with a new revolution after which an idle rider is moving again. */
+    ble_cscs_c_conn_policy_update_t conn_param_update; /**< GAP backend, or NULL for @ref sd_ble_gap_conn_param_update. */
+} ble_cscs_c_conn_policy_config_t;
+
+/**@brief   Adaptive connection parameter policy of a CSC client instance.
+ *
+ * @details Pass a pointer to it in @ref ble_cscs_c_init_t::p_conn_policy and the instance feeds it
+ *          every decoded measurement. The rider becomes idle when no revolution counter advanced
+ *          for idle_timeout ms, and moving again after active_count consecutive measurements
+ *          with a new revolution, so a wheel nudged while parked does not shorten the interval.
+ *          The time between measurements is averaged, starting from idle_timeout, and the idle
+ *          timeout is at least two average intervals, so a sensor notifying only every few
+ *          seconds does not make the policy switch back and forth between two of its measurements.
+ *          The policy starts in @ref BLE_CSCS_C_CONN_POLICY_ACTIVE, assuming the link was
+ *          established with the active parameters.
+ */
+struct ble_cscs_c_conn_policy_s
+{
+    ble_cscs_c_conn_policy_config_t config;         /**< Configuration. */
+    ble_cscs_c_conn_policy_state_t  state;          /**< Current activity state. */
+    bool                            is_last_valid;  /**< True if the fields below are set. */
+    uint8_t                         moving_count;   /**< Consecutive measurements with a new revolution. */
+    uint32_t                        moving_time;    /**< Time of the last new revolution, in ms. */
+    uint32_t                        notif_time;     /**< Time of the last measurement, in ms. */
+    uint32_t                        notif_interval; /**< Average time between measurements, in ms, each at most idle_timeout. */
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    uint32_t                        wheel_revs;     /**< Last Cumulative Wheel Revolutions. */
+#endif
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    uint16_t                        crank_revs;     /**< Last Cumulative Crank Revolutions. */
+#endif
+    uint32_t                        update_count;   /**< Number of connection parameter updates accepted by the GAP backend. */
+};
+
+/**@brief   Function for initializing a connection policy.
+ *
+ * @param[out] p_policy Connection policy.
+ * @param[in]  p_config Configuration.
+ *
+ * @retval  NRF_SUCCESS             If the policy was initialized.
+ * @retval  NRF_ERROR_NULL          If a parameter is NULL.
+ * @retval  NRF_ERROR_INVALID_PARAM If @p idle_timeout or @p active_count is 0.
+ */
+uint32_t ble_cscs_c_conn_policy_init(ble_cscs_c_conn_policy_t              * p_policy,
+                                     ble_cscs_c_conn_policy_config_t const * p_config);
+
+/**@brief   Function for starting the policy over on a new link.
+ *
+ * @details Called by the CSC client instance when a link is assigned.
+ *
+ * @param[in,out] p_policy  Connection policy.
+ */
+void ble_cscs_c_conn_policy_reset(ble_cscs_c_conn_policy_t * p_policy);
+
+/**@brief   Function for passing a decoded measurement to the policy.
+ *
+ * @details Called by the CSC client instance for every decoded measurement. Requests new
+ *          connection parameters when the activity state changes.
+ *
+ * @param[in,out] p_policy      Connection policy.
+ * @param[in]     conn_handle   Connection handle of the link.
+ * @param[in]     timestamp     Time stamp of the measurement, in ms.
+ * @param[in]     p_meas        Measurement.
+ */
+void ble_cscs_c_conn_policy_on_meas(ble_cscs_c_conn_policy_t * p_policy,
+                                    uint16_t                   conn_handle,
+                                    uint32_t                   timestamp,
+                                    ble_cscs_c_meas_t const  * p_meas);
+
+/**@brief   Function for detecting an idle rider on a sensor that stopped notifying.
+ *
+ * @details Many sensors stop notifying when the wheel and crank stand still. Call this function
+ *          periodically, for example every second from an app_timer handler, so the idle
+ *          parameters are requested anyway. It also repeats a request that failed.
+ *
+ * @param[in,out] p_policy      Connection policy.
+ * @param[in]     conn_handle   Connection handle of the link.
+ * @param[in]     timestamp     Current time, in ms.
+ */
+void ble_cscs_c_conn_policy_process(ble_cscs_c_conn_policy_t * p_policy,
+                                    uint16_t                   conn_handle,
+                                    uint32_t                   timestamp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLE_CSCS_C_CONN_POLICY_H__
@@ -0,0 +1,103 @@
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CONTINUITY)
+#include "ble_cscs_c_continuity.h"
+
+STATIC_ASSERT((BLE_CSCS_C_CONTINUITY_PEER_COUNT > 0) && (BLE_CSCS_C_CONTINUITY_PEER_COUNT <= UINT8_MAX), "Invalid peer count.");
+
+/**@brief     Function for comparing two peer addresses.
+ *
+ * @return    True if the addresses are equal.
+ */
+static bool peer_addr_equal(ble_gap_addr_t const * p_addr1, ble_gap_addr_t const * p_addr2)
+{
+    return (p_addr1->addr_type == p_addr2->addr_type) &&
+           (memcmp(p_addr1->addr, p_addr2->addr, BLE_GAP_ADDR_LEN) == 0);
+}
+
+/**@brief     Function for finding the entry of a peer.
+ *
+ * @param[in] p_continuity  Continuity table.
+ * @param[in] p_peer_addr   Address of the peer.
+ *
+ * @return    Pointer to the entry, or NULL if the peer is not in the table.
+ */
+static ble_cscs_c_continuity_entry_t * entry_find(ble_cscs_c_continuity_t const * p_continuity,
+                                                  ble_gap_addr_t const          * p_peer_addr)
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(p_continuity->entries); i++)
+    {
+        ble_cscs_c_continuity_entry_t const * p_entry = &p_continuity->entries[i];
+
+        if (p_entry->is_valid && peer_addr_equal(&p_entry->peer_addr, p_peer_addr))
+        {
+            return (ble_cscs_c_continuity_entry_t *)p_entry;
+        }
+    }
+
+    return NULL;
+}
+
+uint32_t ble_cscs_c_continuity_init(ble_cscs_c_continuity_t * p_continuity)
+{
+    VERIFY_PARAM_NOT_NULL(p_continuity);
+
+    memset(p_continuity, 0, sizeof(*p_continuity));
+
+    return NRF_SUCCESS;
+}
+
+void ble_cscs_c_continuity_store(ble_cscs_c_continuity_t       * p_continuity,
+                                 ble_gap_addr_t const          * p_peer_addr,
+                                 uint32_t                        timestamp,
+                                 ble_cscs_c_calc_state_t const * p_calc_state)
+{
+    ble_cscs_c_continuity_entry_t * p_entry = entry_find(p_continuity, p_peer_addr);
+
+    if (p_entry == NULL)
+    {
+        // Take a free entry, or else the one lost the longest time ago.
+        p_entry = &p_continuity->entries[0];
+
+        for (uint32_t i = 0; (i < ARRAY_SIZE(p_continuity->entries)) && p_entry->is_valid; i++)
+        {
+            ble_cscs_c_continuity_entry_t * p_other = &p_continuity->entries[i];
+
+            if (!p_other->is_valid ||
+                ((timestamp - p_other->disconnect_time) > (timestamp - p_entry->disconnect_time)))
+            {
+                p_entry = p_other;
+            }
+        }
+    }
+
+    p_entry->peer_addr       = *p_peer_addr;
+    p_entry->is_valid        = true;
+    p_entry->disconnect_time = timestamp;
+    p_entry->calc_state      = *p_calc_state;
+}
+
+ble_cscs_c_continuity_entry_t const * ble_cscs_c_continuity_find(ble_cscs_c_continuity_t const * p_continuity,
+                                                                 ble_gap_addr_t const          * p_peer_addr)
+{
+    return entry_find(p_continuity, p_peer_addr);
+}
+
+uint32_t ble_cscs_c_continuity_erase(ble_cscs_c_continuity_t * p_continuity,
+                                     ble_gap_addr_t const    * p_peer_addr)
+{
+    VERIFY_PARAM_NOT_NULL(p_continuity);
+    VERIFY_PARAM_NOT_NULL(p_peer_addr);
+
+    ble_cscs_c_continuity_entry_t * p_entry = entry_find(p_continuity, p_peer_addr);
+
+    if (p_entry == NULL)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    p_entry->is_valid = false;
+
+    return NRF_SUCCESS;
+}
+
+#endif // NRF_MODULE_ENABLED(BLE_CSCS_C_CONTINUITY)
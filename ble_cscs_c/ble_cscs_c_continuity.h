@@ -0,0 +1,87 @@
+#ifndef BLE_CSCS_C_CONTINUITY_H__
+#define BLE_CSCS_C_CONTINUITY_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble_gap.h"
+#include "ble_cscs_c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief   State of a peer kept across a disconnection. */
+typedef struct
+{
+    ble_gap_addr_t          peer_addr;          /**< Address of the peer. */
+    bool                    is_valid;           /**< True if the entry is in use. */
+    uint32_t                disconnect_time;    /**< Time at which the link to the peer was lost, in ms. */
+    ble_cscs_c_calc_state_t calc_state;         /**< Reference counters and distance of the last link. */
+} ble_cscs_c_continuity_entry_t;
+
+/**@brief   Table of peers whose counters are continued on the next link.
+ *
+ * @details Pass a pointer to it in @ref ble_cscs_c_init_t::p_continuity. A table can be shared by
+ *          several instances, so a sensor reconnecting on another instance keeps its totals. When
+ *          the table is full, the entry of the peer lost the longest time ago is replaced.
+ *          The table holds BLE_CSCS_C_CONTINUITY_PEER_COUNT entries of
+ *          @ref ble_cscs_c_continuity_entry_t.
+ */
+struct ble_cscs_c_continuity_s
+{
+    ble_cscs_c_continuity_entry_t entries[BLE_CSCS_C_CONTINUITY_PEER_COUNT]; /**< Entries, one per peer. */
+};
+
+/**@brief   Function for initializing a continuity table, or forgetting all peers.
+ *
+ * @param[out] p_continuity Continuity table.
+ *
+ * @retval  NRF_SUCCESS     If the table was initialized.
+ * @retval  NRF_ERROR_NULL  If @p p_continuity is NULL.
+ */
+uint32_t ble_cscs_c_continuity_init(ble_cscs_c_continuity_t * p_continuity);
+
+/**@brief   Function for storing the state of a peer whose link was lost.
+ *
+ * @details Called by the CSC client instance on disconnection.
+ *
+ * @param[in,out] p_continuity  Continuity table.
+ * @param[in]     p_peer_addr   Address of the peer.
+ * @param[in]     timestamp     Time of the disconnection, in ms.
+ * @param[in]     p_calc_state  State of the speed and cadence calculation.
+ */
+void ble_cscs_c_continuity_store(ble_cscs_c_continuity_t       * p_continuity,
+                                 ble_gap_addr_t const          * p_peer_addr,
+                                 uint32_t                        timestamp,
+                                 ble_cscs_c_calc_state_t const * p_calc_state);
+
+/**@brief   Function for finding the state stored for a peer.
+ *
+ * @details Called by the CSC client instance with the first measurement of a new link. The entry
+ *          stays in the table until it is replaced by @ref ble_cscs_c_continuity_store.
+ *
+ * @param[in] p_continuity  Continuity table.
+ * @param[in] p_peer_addr   Address of the peer.
+ *
+ * @return  Pointer to the entry of the peer, or NULL if there is none.
+ */
+ble_cscs_c_continuity_entry_t const * ble_cscs_c_continuity_find(ble_cscs_c_continuity_t const * p_continuity,
+                                                                 ble_gap_addr_t const          * p_peer_addr);
+
+/**@brief   Function for forgetting a peer, for example when a ride ends.
+ *
+ * @param[in,out] p_continuity  Continuity table.
+ * @param[in]     p_peer_addr   Address of the peer.
+ *
+ * @retval  NRF_SUCCESS         If the entry of the peer was erased.
+ * @retval  NRF_ERROR_NULL      If a parameter is NULL.
+ * @retval  NRF_ERROR_NOT_FOUND If the peer is not in the table.
+ */
+uint32_t ble_cscs_c_continuity_erase(ble_cscs_c_continuity_t * p_continuity,
+                                     ble_gap_addr_t const    * p_peer_addr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLE_CSCS_C_CONTINUITY_H__
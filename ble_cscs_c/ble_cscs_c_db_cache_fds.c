@@ -0,0 +1,147 @@
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_DB_CACHE_FDS)
+#include "ble_cscs_c_db_cache_fds.h"
+#include "fds.h"
+
+#define NRF_LOG_MODULE_NAME ble_cscs_c_db_cache_fds
+#include "nrf_log.h"
+NRF_LOG_MODULE_REGISTER();
+
+/**@brief   Content of a cache record. */
+typedef struct
+{
+    ble_gap_addr_t  peer_addr;  /**< Address of the peer. */
+    ble_cscs_c_db_t peer_db;    /**< Handles discovered on the peer. */
+} db_cache_record_t;
+
+/**@brief   Record buffer, word aligned as required by FDS. */
+typedef union
+{
+    db_cache_record_t record;
+    uint32_t          words[BYTES_TO_WORDS(sizeof(db_cache_record_t))];
+} db_cache_record_buf_t;
+
+/**@brief   Buffers of records being written. FDS reads them after @ref fds_record_write or
+ *          @ref fds_record_update returns, so one is kept per link that may store at the same time.
+ */
+static db_cache_record_buf_t m_record_bufs[NRF_SDH_BLE_CENTRAL_LINK_COUNT];
+static uint8_t               m_record_buf_idx;
+
+static bool peer_addr_equal(ble_gap_addr_t const * p_addr1, ble_gap_addr_t const * p_addr2)
+{
+    return (p_addr1->addr_type == p_addr2->addr_type) &&
+           (memcmp(p_addr1->addr, p_addr2->addr, BLE_GAP_ADDR_LEN) == 0);
+}
+
+/**@brief     Function for finding the record of a peer.
+ *
+ * @param[in]  p_peer_addr Address of the peer.
+ * @param[out] p_desc      Descriptor of the record, if found.
+ * @param[out] p_peer_db   Handles stored in the record, if found. Can be NULL.
+ *
+ * @retval     NRF_SUCCESS         If the record was found.
+ * @retval     NRF_ERROR_NOT_FOUND Otherwise.
+ */
+static uint32_t record_find(ble_gap_addr_t const * p_peer_addr,
+                            fds_record_desc_t    * p_desc,
+                            ble_cscs_c_db_t      * p_peer_db)
+{
+    fds_find_token_t token;
+
+    memset(&token, 0, sizeof(token));
+
+    while (fds_record_find(BLE_CSCS_C_DB_CACHE_FDS_FILE_ID,
+                           BLE_CSCS_C_DB_CACHE_FDS_RECORD_KEY,
+                           p_desc,
+                           &token) == NRF_SUCCESS)
+    {
+        fds_flash_record_t flash_record;
+        bool               found;
+
+        if (fds_record_open(p_desc, &flash_record) != NRF_SUCCESS)
+        {
+            continue;
+        }
+
+        db_cache_record_t const * p_record = (db_cache_record_t const *)flash_record.p_data;
+
+        found = peer_addr_equal(&p_record->peer_addr, p_peer_addr);
+        if (found && (p_peer_db != NULL))
+        {
+            *p_peer_db = p_record->peer_db;
+        }
+
+        (void)fds_record_close(p_desc);
+
+        if (found)
+        {
+            return NRF_SUCCESS;
+        }
+    }
+
+    return NRF_ERROR_NOT_FOUND;
+}
+
+static uint32_t db_cache_load(ble_gap_addr_t const * p_peer_addr, ble_cscs_c_db_t * p_peer_db)
+{
+    fds_record_desc_t desc;
+
+    return record_find(p_peer_addr, &desc, p_peer_db);
+}
+
+static uint32_t db_cache_store(ble_gap_addr_t const * p_peer_addr, ble_cscs_c_db_t const * p_peer_db)
+{
+    fds_record_desc_t       desc;
+    ble_cscs_c_db_t         stored_db;
+    db_cache_record_buf_t * p_buf = &m_record_bufs[m_record_buf_idx];
+    fds_record_t            record;
+    ret_code_t              err_code;
+    bool                    found = (record_find(p_peer_addr, &desc, &stored_db) == NRF_SUCCESS);
+
+    if (found && (memcmp(&stored_db, p_peer_db, sizeof(stored_db)) == 0))
+    {
+        return NRF_SUCCESS;
+    }
+
+    memset(p_buf, 0, sizeof(*p_buf));
+    p_buf->record.peer_addr = *p_peer_addr;
+    p_buf->record.peer_db   = *p_peer_db;
+
+    record.file_id           = BLE_CSCS_C_DB_CACHE_FDS_FILE_ID;
+    record.key               = BLE_CSCS_C_DB_CACHE_FDS_RECORD_KEY;
+    record.data.p_data       = p_buf->words;
+    record.data.length_words = ARRAY_SIZE(p_buf->words);
+
+    err_code = found ? fds_record_update(&desc, &record) : fds_record_write(&desc, &record);
+    if (err_code == NRF_SUCCESS)
+    {
+        m_record_buf_idx = (m_record_buf_idx + 1) % ARRAY_SIZE(m_record_bufs);
+    }
+    else
+    {
+        NRF_LOG_WARNING("Writing record failed, error: %d", err_code);
+    }
+
+    return err_code;
+}
+
+static uint32_t db_cache_erase(ble_gap_addr_t const * p_peer_addr)
+{
+    fds_record_desc_t desc;
+
+    if (record_find(p_peer_addr, &desc, NULL) != NRF_SUCCESS)
+    {
+        return NRF_SUCCESS;
+    }
+
+    return fds_record_delete(&desc);
+}
+
+ble_cscs_c_db_cache_t const ble_cscs_c_db_cache_fds =
+{
+    .load  = db_cache_load,
+    .store = db_cache_store,
+    .erase = db_cache_erase
+};
+
+#endif // NRF_MODULE_ENABLED(BLE_CSCS_C_DB_CACHE_FDS)
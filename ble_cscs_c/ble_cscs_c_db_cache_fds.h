@@ -0,0 +1,23 @@
+#ifndef BLE_CSCS_C_DB_CACHE_FDS_H__
+#define BLE_CSCS_C_DB_CACHE_FDS_H__
+
+#include "ble_cscs_c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief   Discovered handle cache backend storing one record per peer in Flash Data Storage.
+ *
+ * @details Pass a pointer to it in @ref ble_cscs_c_init_t::p_db_cache. Records are written to
+ *          the file BLE_CSCS_C_DB_CACHE_FDS_FILE_ID with the key BLE_CSCS_C_DB_CACHE_FDS_RECORD_KEY.
+ *          The application must initialize FDS with @ref fds_init before the first connection and
+ *          is responsible for running garbage collection.
+ */
+extern ble_cscs_c_db_cache_t const ble_cscs_c_db_cache_fds;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLE_CSCS_C_DB_CACHE_FDS_H__
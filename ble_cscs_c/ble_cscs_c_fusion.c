@@ -0,0 +1,230 @@
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_FUSION)
+#include "ble_cscs_c_fusion.h"
+
+#if !BLE_CSCS_C_WHEEL_SUPPORTED || !BLE_CSCS_C_CRANK_SUPPORTED
+#error "BLE_CSCS_C_FUSION requires BLE_CSCS_C_WHEEL_SUPPORTED and BLE_CSCS_C_CRANK_SUPPORTED."
+#endif
+
+#define TICKS_PER_SEC       1024                                        /**< Resolution of the event times. */
+#define MS_PER_SEC          1000                                        /**< Milliseconds per second. */
+#define TICKS_PER_DRIFT     (1000000 / BLE_CSCS_C_FUSION_MAX_DRIFT_PPM) /**< Elapsed time after which the offset may grow by one tick. */
+
+STATIC_ASSERT((BLE_CSCS_C_FUSION_MAX_DRIFT_PPM > 0) && (BLE_CSCS_C_FUSION_MAX_DRIFT_PPM <= 1000000), "Invalid drift.");
+
+/**@brief     Function for bringing the central clock up to date.
+ *
+ * @details   The time in milliseconds is converted into 1/1024 s without accumulating rounding
+ *            errors, so the central clock wraps around at the same point as the event times.
+ *
+ * @param[in,out] p_fusion  Fusion structure.
+ */
+static void clock_update(ble_cscs_c_fusion_t * p_fusion)
+{
+    uint32_t now     = p_fusion->timestamp_get();
+    uint32_t elapsed = now - p_fusion->clock_ms;
+
+    p_fusion->clock_ms   = now;
+    p_fusion->clock     += (elapsed / MS_PER_SEC) * TICKS_PER_SEC;
+    p_fusion->clock_rem += (elapsed % MS_PER_SEC) * TICKS_PER_SEC;
+    p_fusion->clock     += p_fusion->clock_rem / MS_PER_SEC;
+    p_fusion->clock_rem %= MS_PER_SEC;
+}
+
+/**@brief     Function for updating the mapping of a sensor clock with a new event time.
+ *
+ * @param[in]     clock         Central time at which the event time was received.
+ * @param[in,out] p_source      Sensor.
+ * @param[in]     event_time    Event time of the measurement.
+ */
+static void source_time_update(uint32_t                     clock,
+                               ble_cscs_c_fusion_source_t * p_source,
+                               uint16_t                     event_time)
+{
+    if (!p_source->is_valid)
+    {
+        p_source->sensor_time = event_time;
+        p_source->offset      = clock - event_time;
+        p_source->offset_time = clock;
+        p_source->drift_acc   = 0;
+    }
+    else if (event_time != p_source->event_time)
+    {
+        p_source->sensor_time += (uint16_t)(event_time - p_source->event_time);
+
+        // Let the offset follow a slower sensor clock, within the tolerance of the clocks.
+        p_source->drift_acc   += clock - p_source->offset_time;
+        p_source->offset      += p_source->drift_acc / TICKS_PER_DRIFT;
+        p_source->drift_acc   %= TICKS_PER_DRIFT;
+        p_source->offset_time  = clock;
+
+        uint32_t offset = clock - p_source->sensor_time;
+
+        if ((int32_t)(offset - p_source->offset) < 0)
+        {
+            p_source->offset = offset;
+        }
+    }
+
+    p_source->event_time = event_time;
+}
+
+/**@brief     Function for combining the last measurements of both sensors.
+ *
+ * @param[in,out] p_fusion  Fusion structure.
+ */
+static void fuse(ble_cscs_c_fusion_t * p_fusion)
+{
+    ble_cscs_c_fusion_source_t * p_wheel = &p_fusion->source[BLE_CSCS_C_FUSION_WHEEL];
+    ble_cscs_c_fusion_source_t * p_crank = &p_fusion->source[BLE_CSCS_C_FUSION_CRANK];
+    ble_cscs_c_meas_t            meas;
+
+    memset(&meas, 0, sizeof(meas));
+
+    if (p_wheel->is_valid)
+    {
+        meas.is_wheel_rev_data_present = true;
+        meas.cumulative_wheel_revs     = p_wheel->meas.cumulative_wheel_revs;
+        meas.last_wheel_event_time     = (uint16_t)(p_wheel->sensor_time + p_wheel->offset);
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CALC)
+        meas.calc.is_speed_valid       = p_wheel->meas.calc.is_speed_valid;
+        meas.calc.speed                = p_wheel->meas.calc.speed;
+        meas.calc.distance             = p_wheel->meas.calc.distance;
+#endif
+    }
+    if (p_crank->is_valid)
+    {
+        meas.is_crank_rev_data_present = true;
+        meas.cumulative_crank_revs     = p_crank->meas.cumulative_crank_revs;
+        meas.last_crank_event_time     = (uint16_t)(p_crank->sensor_time + p_crank->offset);
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_CALC)
+        meas.calc.is_cadence_valid     = p_crank->meas.calc.is_cadence_valid;
+        meas.calc.cadence              = p_crank->meas.calc.cadence;
+#endif
+    }
+
+    p_wheel->is_fresh = false;
+    p_crank->is_fresh = false;
+
+    p_fusion->evt_handler(p_fusion, &meas);
+}
+
+uint32_t ble_cscs_c_fusion_init(ble_cscs_c_fusion_t            * p_fusion,
+                                ble_cscs_c_fusion_init_t const * p_fusion_init)
+{
+    VERIFY_PARAM_NOT_NULL(p_fusion);
+    VERIFY_PARAM_NOT_NULL(p_fusion_init);
+    VERIFY_PARAM_NOT_NULL(p_fusion_init->evt_handler);
+    VERIFY_PARAM_NOT_NULL(p_fusion_init->timestamp_get);
+
+    memset(p_fusion, 0, sizeof(*p_fusion));
+
+    p_fusion->evt_handler   = p_fusion_init->evt_handler;
+    p_fusion->timestamp_get = p_fusion_init->timestamp_get;
+    p_fusion->max_latency   = ((uint32_t)p_fusion_init->max_latency_ms * TICKS_PER_SEC) / MS_PER_SEC;
+    p_fusion->clock_ms      = p_fusion->timestamp_get();
+
+    return ble_cscs_c_fusion_pair(p_fusion, BLE_CONN_HANDLE_INVALID, BLE_CONN_HANDLE_INVALID);
+}
+
+uint32_t ble_cscs_c_fusion_pair(ble_cscs_c_fusion_t * p_fusion,
+                                uint16_t              wheel_conn_handle,
+                                uint16_t              crank_conn_handle)
+{
+    VERIFY_PARAM_NOT_NULL(p_fusion);
+
+    uint16_t const conn_handles[BLE_CSCS_C_FUSION_SOURCE_COUNT] = {wheel_conn_handle, crank_conn_handle};
+
+    for (uint32_t i = 0; i < BLE_CSCS_C_FUSION_SOURCE_COUNT; i++)
+    {
+        ble_cscs_c_fusion_source_t * p_source = &p_fusion->source[i];
+
+        if (p_source->conn_handle != conn_handles[i])
+        {
+            memset(p_source, 0, sizeof(*p_source));
+            p_source->conn_handle = conn_handles[i];
+        }
+    }
+
+    return NRF_SUCCESS;
+}
+
+void ble_cscs_c_fusion_on_meas(ble_cscs_c_fusion_t     * p_fusion,
+                               ble_cscs_c_t const      * p_ble_cscs_c,
+                               ble_cscs_c_meas_t const * p_meas)
+{
+    if ((p_fusion == NULL) || (p_ble_cscs_c == NULL) || (p_meas == NULL) ||
+        (p_ble_cscs_c->conn_handle == BLE_CONN_HANDLE_INVALID))
+    {
+        return;
+    }
+
+    clock_update(p_fusion);
+
+    for (uint32_t i = 0; i < BLE_CSCS_C_FUSION_SOURCE_COUNT; i++)
+    {
+        ble_cscs_c_fusion_source_t * p_source = &p_fusion->source[i];
+        bool is_present = (i == BLE_CSCS_C_FUSION_WHEEL) ? p_meas->is_wheel_rev_data_present
+                                                         : p_meas->is_crank_rev_data_present;
+
+        if ((p_source->conn_handle != p_ble_cscs_c->conn_handle) || !is_present)
+        {
+            continue;
+        }
+
+        source_time_update(p_fusion->clock,
+                           p_source,
+                           (i == BLE_CSCS_C_FUSION_WHEEL) ? p_meas->last_wheel_event_time
+                                                          : p_meas->last_crank_event_time);
+
+        if (!p_fusion->source[BLE_CSCS_C_FUSION_WHEEL].is_fresh &&
+            !p_fusion->source[BLE_CSCS_C_FUSION_CRANK].is_fresh)
+        {
+            p_fusion->pending_time = p_fusion->clock;
+        }
+        else if (p_source->is_fresh)
+        {
+            // A second measurement of the same sensor: pass the first one on.
+            fuse(p_fusion);
+            p_fusion->pending_time = p_fusion->clock;
+        }
+
+        p_source->meas     = *p_meas;
+        p_source->is_valid = true;
+        p_source->is_fresh = true;
+    }
+
+    ble_cscs_c_fusion_source_t const * p_wheel = &p_fusion->source[BLE_CSCS_C_FUSION_WHEEL];
+    ble_cscs_c_fusion_source_t const * p_crank = &p_fusion->source[BLE_CSCS_C_FUSION_CRANK];
+
+    // Without a second sensor there is nothing to wait for.
+    if ((p_wheel->is_fresh || (p_wheel->conn_handle == BLE_CONN_HANDLE_INVALID)) &&
+        (p_crank->is_fresh || (p_crank->conn_handle == BLE_CONN_HANDLE_INVALID)) &&
+        (p_wheel->is_fresh || p_crank->is_fresh))
+    {
+        fuse(p_fusion);
+    }
+}
+
+void ble_cscs_c_fusion_process(ble_cscs_c_fusion_t * p_fusion)
+{
+    if (p_fusion == NULL)
+    {
+        return;
+    }
+
+    if (!p_fusion->source[BLE_CSCS_C_FUSION_WHEEL].is_fresh &&
+        !p_fusion->source[BLE_CSCS_C_FUSION_CRANK].is_fresh)
+    {
+        return;
+    }
+
+    clock_update(p_fusion);
+
+    if ((p_fusion->clock - p_fusion->pending_time) >= p_fusion->max_latency)
+    {
+        fuse(p_fusion);
+    }
+}
+
+#endif // NRF_MODULE_ENABLED(BLE_CSCS_C_FUSION)
@@ -0,0 +1,129 @@
+#ifndef BLE_CSCS_C_FUSION_H__
+#define BLE_CSCS_C_FUSION_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble_cscs_c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief   Sources of a fused measurement. */
+typedef enum
+{
+    BLE_CSCS_C_FUSION_WHEEL,    /**< Sensor providing the Wheel Revolution Data. */
+    BLE_CSCS_C_FUSION_CRANK,    /**< Sensor providing the Crank Revolution Data. */
+    BLE_CSCS_C_FUSION_SOURCE_COUNT
+} ble_cscs_c_fusion_source_id_t;
+
+/**@brief   State of one sensor feeding the fusion.
+ *
+ * @details The event times of the sensor are extended to 32 bits in @p sensor_time and mapped to
+ *          the central clock with @p offset. The offset is the smallest difference seen between
+ *          the time a new event was received and its event time, which is the one with the least
+ *          transmission delay. It is allowed to grow by BLE_CSCS_C_FUSION_MAX_DRIFT_PPM so that it
+ *          follows a sensor clock running slower than the central one.
+ */
+typedef struct
+{
+    uint16_t          conn_handle;      /**< Connection handle of the sensor, or BLE_CONN_HANDLE_INVALID. */
+    bool              is_valid;         /**< True if @p meas and @p offset are set. */
+    bool              is_fresh;         /**< True if @p meas was received after the last fused measurement. */
+    uint16_t          event_time;       /**< Last event time received from the sensor, in 1/1024 s. */
+    uint32_t          sensor_time;      /**< Last event time extended to 32 bits, in 1/1024 s. */
+    uint32_t          offset;           /**< Central time minus sensor time, in 1/1024 s. */
+    uint32_t          offset_time;      /**< Central time at which @p offset was last updated, in 1/1024 s. */
+    uint32_t          drift_acc;        /**< Elapsed time not yet converted into an offset increase, in 1/1024 s. */
+    ble_cscs_c_meas_t meas;             /**< Last measurement received from the sensor. */
+} ble_cscs_c_fusion_source_t;
+
+// Forward declaration of the ble_cscs_c_fusion_t type.
+typedef struct ble_cscs_c_fusion_s ble_cscs_c_fusion_t;
+
+/**@brief   Fused measurement handler type.
+ *
+ * @details @p p_meas has the Wheel Revolution Data of the wheel sensor and the Crank Revolution
+ *          Data of the crank sensor. Both event times are on the central clock, so they can be
+ *          compared with each other.
+ */
+typedef void (* ble_cscs_c_fusion_evt_handler_t)(ble_cscs_c_fusion_t * p_fusion, ble_cscs_c_meas_t const * p_meas);
+
+/**@brief   Speed and cadence fusion structure. */
+struct ble_cscs_c_fusion_s
+{
+    ble_cscs_c_fusion_evt_handler_t evt_handler;     /**< Handler of the fused measurements. */
+    ble_cscs_c_timestamp_get_t      timestamp_get;   /**< Function for getting the central time in milliseconds. */
+    uint32_t                        max_latency;     /**< Longest time a measurement waits for the other sensor, in 1/1024 s. */
+    uint32_t                        clock;           /**< Central time, in 1/1024 s. */
+    uint32_t                        clock_ms;        /**< Central time at which @p clock was updated, in ms. */
+    uint32_t                        clock_rem;       /**< Remainder of the conversion of @p clock_ms into @p clock. */
+    uint32_t                        pending_time;    /**< Central time at which the oldest unfused measurement was received, in 1/1024 s. */
+    ble_cscs_c_fusion_source_t      source[BLE_CSCS_C_FUSION_SOURCE_COUNT]; /**< Wheel and crank sensors. */
+};
+
+/**@brief   Speed and cadence fusion initialization structure. */
+typedef struct
+{
+    ble_cscs_c_fusion_evt_handler_t evt_handler;     /**< Handler of the fused measurements. */
+    ble_cscs_c_timestamp_get_t      timestamp_get;   /**< Function for getting the central time in milliseconds. */
+    uint16_t                        max_latency_ms;  /**< Longest time a measurement waits for the other sensor, in ms. */
+} ble_cscs_c_fusion_init_t;
+
+/**@brief   Function for initializing the speed and cadence fusion.
+ *
+ * @param[out] p_fusion         Fusion structure.
+ * @param[in]  p_fusion_init    Initialization parameters.
+ *
+ * @retval  NRF_SUCCESS     If the fusion was initialized.
+ * @retval  NRF_ERROR_NULL  If a parameter or a function pointer is NULL.
+ */
+uint32_t ble_cscs_c_fusion_init(ble_cscs_c_fusion_t            * p_fusion,
+                                ble_cscs_c_fusion_init_t const * p_fusion_init);
+
+/**@brief   Function for assigning the connections of the wheel and crank sensors.
+ *
+ * @details Call it when a sensor connects or disconnects. A source whose connection handle
+ *          changes starts again from its next measurement.
+ *
+ * @param[in,out] p_fusion          Fusion structure.
+ * @param[in]     wheel_conn_handle Connection handle of the wheel sensor, or BLE_CONN_HANDLE_INVALID.
+ * @param[in]     crank_conn_handle Connection handle of the crank sensor, or BLE_CONN_HANDLE_INVALID.
+ *
+ * @retval  NRF_SUCCESS     If the connections were assigned.
+ * @retval  NRF_ERROR_NULL  If a parameter is NULL.
+ */
+uint32_t ble_cscs_c_fusion_pair(ble_cscs_c_fusion_t * p_fusion,
+                                uint16_t              wheel_conn_handle,
+                                uint16_t              crank_conn_handle);
+
+/**@brief   Function for passing a measurement of a CSC client instance to the fusion.
+ *
+ * @details Call it from the event handler of the instance on @ref BLE_CSCS_C_EVT_CSM_NOTIFICATION
+ *          or for every measurement drained with @ref ble_cscs_c_drain. Measurements of
+ *          connections that are not paired are ignored. A fused measurement is passed to the
+ *          handler as soon as both sensors have sent a measurement.
+ *
+ * @param[in,out] p_fusion      Fusion structure.
+ * @param[in]     p_ble_cscs_c  CSC client instance that received the measurement.
+ * @param[in]     p_meas        Measurement.
+ */
+void ble_cscs_c_fusion_on_meas(ble_cscs_c_fusion_t     * p_fusion,
+                               ble_cscs_c_t const      * p_ble_cscs_c,
+                               ble_cscs_c_meas_t const * p_meas);
+
+/**@brief   Function for passing on measurements that waited too long for the other sensor.
+ *
+ * @details Call it periodically, for example from an app_timer handler firing every
+ *          max_latency_ms. A measurement is then passed on at most twice max_latency_ms after it
+ *          was received, with the last values of the silent sensor.
+ *
+ * @param[in,out] p_fusion  Fusion structure.
+ */
+void ble_cscs_c_fusion_process(ble_cscs_c_fusion_t * p_fusion);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLE_CSCS_C_FUSION_H__
@@ -0,0 +1,232 @@
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(BLE_CSCS_C_STATS)
+#include "ble_cscs_c_stats.h"
+
+STATIC_ASSERT((BLE_CSCS_C_STATS_SHORT_WINDOW > 0) && (BLE_CSCS_C_STATS_SHORT_WINDOW <= UINT8_MAX), "Invalid short window.");
+STATIC_ASSERT((BLE_CSCS_C_STATS_LONG_WINDOW > 0) && (BLE_CSCS_C_STATS_LONG_WINDOW <= UINT8_MAX), "Invalid long window.");
+
+#define MS_PER_SEC  1000    /**< Milliseconds per second. */
+
+static void window_init(ble_cscs_c_stats_window_t * p_window,
+                        ble_cscs_c_stats_bucket_t * p_buckets,
+                        uint8_t                     size)
+{
+    memset(p_window, 0, sizeof(*p_window));
+    memset(p_buckets, 0, size * sizeof(*p_buckets));
+
+    p_window->p_buckets = p_buckets;
+    p_window->size      = size;
+}
+
+/**@brief     Function for moving the head of a window to the second of a new sample.
+ *
+ * @details   Buckets that fall out of the window are removed from the running totals. The cost is
+ *            bounded by the window size and amortized to one bucket per second. Seconds are
+ *            counted from the first sample, with the time elapsed modulo 2^32 ms, so the window
+ *            keeps advancing when the time stamp wraps around.
+ *
+ * @param[in,out] p_window  Window.
+ * @param[in]     timestamp Time stamp of the new sample, in ms.
+ */
+static void window_advance(ble_cscs_c_stats_window_t * p_window, uint32_t timestamp)
+{
+    if (!p_window->is_started)
+    {
+        p_window->is_started = true;
+        p_window->head_time  = timestamp;
+        return;
+    }
+
+    uint32_t elapsed = timestamp - p_window->head_time;
+
+    // Samples with an older time stamp go into the newest bucket.
+    if ((elapsed < MS_PER_SEC) || (elapsed > INT32_MAX))
+    {
+        return;
+    }
+
+    uint32_t steps = elapsed / MS_PER_SEC;
+
+    p_window->head_time += steps * MS_PER_SEC;
+    steps                = MIN(steps, p_window->size);
+
+    for (uint32_t i = 0; i < steps; i++)
+    {
+        p_window->head = (uint8_t)((p_window->head + 1) % p_window->size);
+
+        ble_cscs_c_stats_bucket_t * p_bucket = &p_window->p_buckets[p_window->head];
+
+        p_window->speed_sum   -= p_bucket->speed_sum;
+        p_window->speed_count -= p_bucket->speed_count;
+        p_window->distance    -= p_bucket->distance;
+        p_window->moving_time -= p_bucket->is_moving ? 1 : 0;
+
+        memset(p_bucket, 0, sizeof(*p_bucket));
+    }
+}
+
+static void window_add(ble_cscs_c_stats_window_t * p_window,
+                       uint32_t                    timestamp,
+                       ble_cscs_c_meas_t const   * p_meas,
+                       uint32_t                    distance,
+                       bool                        is_moving)
+{
+    window_advance(p_window, timestamp);
+
+    ble_cscs_c_stats_bucket_t * p_bucket = &p_window->p_buckets[p_window->head];
+
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    if (p_meas->calc.is_speed_valid && (p_bucket->speed_count < UINT8_MAX))
+    {
+        p_bucket->speed_sum   += p_meas->calc.speed;
+        p_bucket->speed_count++;
+        p_window->speed_sum   += p_meas->calc.speed;
+        p_window->speed_count++;
+    }
+#endif
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    if (p_meas->calc.is_cadence_valid)
+    {
+        p_bucket->cadence_max = MAX(p_bucket->cadence_max, p_meas->calc.cadence);
+    }
+#endif
+
+    distance = MIN(distance, (uint32_t)(UINT16_MAX - p_bucket->distance));
+    p_bucket->distance += (uint16_t)distance;
+    p_window->distance += distance;
+
+    if (is_moving && !p_bucket->is_moving)
+    {
+        p_bucket->is_moving = true;
+        p_window->moving_time++;
+    }
+}
+
+static void window_get(ble_cscs_c_stats_window_t const * p_window, ble_cscs_c_stats_result_t * p_result)
+{
+    p_result->avg_speed   = (p_window->speed_count != 0) ? (p_window->speed_sum / p_window->speed_count) : 0;
+    p_result->distance    = p_window->distance;
+    p_result->moving_time = p_window->moving_time;
+    p_result->max_cadence = 0;
+
+    for (uint32_t i = 0; i < p_window->size; i++)
+    {
+        p_result->max_cadence = MAX(p_result->max_cadence, p_window->p_buckets[i].cadence_max);
+    }
+}
+
+uint32_t ble_cscs_c_stats_init(ble_cscs_c_stats_t * p_stats)
+{
+    VERIFY_PARAM_NOT_NULL(p_stats);
+
+    window_init(&p_stats->short_window, p_stats->short_buckets, BLE_CSCS_C_STATS_SHORT_WINDOW);
+    window_init(&p_stats->long_window, p_stats->long_buckets, BLE_CSCS_C_STATS_LONG_WINDOW);
+
+    p_stats->is_distance_valid = false;
+
+    return ble_cscs_c_stats_lap_reset(p_stats);
+}
+
+void ble_cscs_c_stats_update(ble_cscs_c_stats_t      * p_stats,
+                             uint32_t                  timestamp,
+                             ble_cscs_c_meas_t const * p_meas)
+{
+    uint32_t distance  = 0;
+    bool     is_moving = false;
+
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    is_moving = p_meas->calc.is_cadence_valid && (p_meas->calc.cadence != 0);
+#endif
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    is_moving = is_moving || (p_meas->calc.is_speed_valid && (p_meas->calc.speed != 0));
+
+    if (p_meas->calc.is_speed_valid)
+    {
+        // The distance restarts from 0 on a new link.
+        if (p_stats->is_distance_valid && (p_meas->calc.distance >= p_stats->distance))
+        {
+            distance = p_meas->calc.distance - p_stats->distance;
+        }
+        p_stats->distance          = p_meas->calc.distance;
+        p_stats->is_distance_valid = true;
+    }
+#endif
+
+    window_add(&p_stats->short_window, timestamp, p_meas, distance, is_moving);
+    window_add(&p_stats->long_window, timestamp, p_meas, distance, is_moving);
+
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    if (p_meas->calc.is_speed_valid)
+    {
+        p_stats->lap_speed_sum = (p_stats->lap_speed_sum > (UINT32_MAX - p_meas->calc.speed))
+                                 ? UINT32_MAX
+                                 : (p_stats->lap_speed_sum + p_meas->calc.speed);
+        p_stats->lap_speed_count++;
+    }
+#endif
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    if (p_meas->calc.is_cadence_valid)
+    {
+        p_stats->lap_cadence_max = MAX(p_stats->lap_cadence_max, p_meas->calc.cadence);
+    }
+#endif
+
+    p_stats->lap_distance += distance;
+
+    // The lap counts seconds on the buckets of the windows.
+    if (is_moving && (!p_stats->is_lap_moving || (p_stats->lap_moving_sec != p_stats->short_window.head_time)))
+    {
+        p_stats->lap_moving_time++;
+        p_stats->lap_moving_sec = p_stats->short_window.head_time;
+        p_stats->is_lap_moving  = true;
+    }
+}
+
+uint32_t ble_cscs_c_stats_get(ble_cscs_c_stats_t const     * p_stats,
+                              ble_cscs_c_stats_window_id_t   window,
+                              ble_cscs_c_stats_result_t    * p_result)
+{
+    VERIFY_PARAM_NOT_NULL(p_stats);
+    VERIFY_PARAM_NOT_NULL(p_result);
+
+    switch (window)
+    {
+        case BLE_CSCS_C_STATS_SHORT:
+            window_get(&p_stats->short_window, p_result);
+            break;
+
+        case BLE_CSCS_C_STATS_LONG:
+            window_get(&p_stats->long_window, p_result);
+            break;
+
+        case BLE_CSCS_C_STATS_LAP:
+            p_result->avg_speed   = (p_stats->lap_speed_count != 0)
+                                    ? (p_stats->lap_speed_sum / p_stats->lap_speed_count)
+                                    : 0;
+            p_result->max_cadence = p_stats->lap_cadence_max;
+            p_result->distance    = p_stats->lap_distance;
+            p_result->moving_time = p_stats->lap_moving_time;
+            break;
+
+        default:
+            return NRF_ERROR_INVALID_PARAM;
+    }
+
+    return NRF_SUCCESS;
+}
+
+uint32_t ble_cscs_c_stats_lap_reset(ble_cscs_c_stats_t * p_stats)
+{
+    VERIFY_PARAM_NOT_NULL(p_stats);
+
+    p_stats->lap_speed_sum   = 0;
+    p_stats->lap_speed_count = 0;
+    p_stats->lap_distance    = 0;
+    p_stats->lap_moving_time = 0;
+    p_stats->lap_cadence_max = 0;
+    p_stats->is_lap_moving   = false;
+
+    return NRF_SUCCESS;
+}
+
+#endif // NRF_MODULE_ENABLED(BLE_CSCS_C_STATS)
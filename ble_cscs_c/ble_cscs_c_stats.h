@@ -0,0 +1,132 @@
+#ifndef BLE_CSCS_C_STATS_H__
+#define BLE_CSCS_C_STATS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble_cscs_c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief   Ride statistics windows. */
+typedef enum
+{
+    BLE_CSCS_C_STATS_SHORT,     /**< Last BLE_CSCS_C_STATS_SHORT_WINDOW seconds. */
+    BLE_CSCS_C_STATS_LONG,      /**< Last BLE_CSCS_C_STATS_LONG_WINDOW seconds. */
+    BLE_CSCS_C_STATS_LAP        /**< Since the last call to @ref ble_cscs_c_stats_lap_reset. */
+} ble_cscs_c_stats_window_id_t;
+
+/**@brief   Ride statistics over a window. */
+typedef struct
+{
+    uint32_t avg_speed;         /**< Average of the speed samples, in mm/s. */
+    uint16_t max_cadence;       /**< Highest cadence, in 1/10 rpm. */
+    uint32_t distance;          /**< Distance travelled, in metres. */
+    uint32_t moving_time;       /**< Number of seconds with a non-zero speed or cadence. */
+} ble_cscs_c_stats_result_t;
+
+/**@brief   Samples received during one second. */
+typedef struct
+{
+    uint32_t speed_sum;         /**< Sum of the speed samples, in mm/s. */
+    uint16_t cadence_max;       /**< Highest cadence, in 1/10 rpm. */
+    uint16_t distance;          /**< Distance travelled, in metres. */
+    uint8_t  speed_count;       /**< Number of speed samples. */
+    bool     is_moving;         /**< True if the speed or cadence was non-zero. */
+} ble_cscs_c_stats_bucket_t;
+
+/**@brief   Sliding window of one-second buckets with running totals. */
+typedef struct
+{
+    ble_cscs_c_stats_bucket_t * p_buckets;      /**< Buckets, one per second of the window. */
+    uint8_t                     size;           /**< Number of buckets. */
+    uint8_t                     head;           /**< Index of the bucket of @p head_time. */
+    bool                        is_started;     /**< True if @p head_time is valid. */
+    uint32_t                    head_time;      /**< Time stamp at which the newest bucket starts, in ms. */
+    uint32_t                    speed_sum;      /**< Sum of the speed samples in the window, in mm/s. */
+    uint32_t                    speed_count;    /**< Number of speed samples in the window. */
+    uint32_t                    distance;       /**< Distance travelled in the window, in metres. */
+    uint32_t                    moving_time;    /**< Number of buckets in the window with @p is_moving set. */
+} ble_cscs_c_stats_window_t;
+
+/**@brief   Ride statistics of a CSC client instance.
+ *
+ * @details Pass a pointer to it in @ref ble_cscs_c_init_t::p_stats and the instance updates it
+ *          with every decoded measurement, in constant time. The sliding windows keep one bucket
+ *          per second, counted from the first measurement; their maxima are only computed by
+ *          @ref ble_cscs_c_stats_get. Memory used per instance for some window sizes (Cortex-M,
+ *          32-bit pointers):
+ *          | SHORT_WINDOW | LONG_WINDOW | Size in bytes |
+ *          |--------------|-------------|---------------|
+ *          | 3            | 30          | 480           |
+ *          | 3            | 60          | 840           |
+ *          | 5            | 120         | 1584          |
+ *          | 10           | 240         | 3084          |
+ */
+struct ble_cscs_c_stats_s
+{
+    ble_cscs_c_stats_bucket_t short_buckets[BLE_CSCS_C_STATS_SHORT_WINDOW]; /**< Buckets of the short window. */
+    ble_cscs_c_stats_bucket_t long_buckets[BLE_CSCS_C_STATS_LONG_WINDOW];   /**< Buckets of the long window. */
+    ble_cscs_c_stats_window_t short_window;     /**< Short sliding window. */
+    ble_cscs_c_stats_window_t long_window;      /**< Long sliding window. */
+    uint32_t                  lap_speed_sum;    /**< Sum of the speed samples since the lap started, in mm/s. Saturates. */
+    uint32_t                  lap_speed_count;  /**< Number of speed samples since the lap started. */
+    uint32_t                  lap_distance;     /**< Distance travelled since the lap started, in metres. */
+    uint32_t                  lap_moving_time;  /**< Number of seconds with movement since the lap started. */
+    uint32_t                  lap_moving_sec;   /**< Start of the last second counted in @p lap_moving_time, in ms. */
+    uint16_t                  lap_cadence_max;  /**< Highest cadence since the lap started, in 1/10 rpm. */
+    bool                      is_lap_moving;    /**< True if @p lap_moving_sec is valid. */
+    bool                      is_distance_valid;/**< True if @p distance is valid. */
+    uint32_t                  distance;         /**< Distance of the previous measurement, in metres. */
+};
+
+/**@brief   Function for initializing the ride statistics.
+ *
+ * @param[out] p_stats  Ride statistics.
+ *
+ * @retval  NRF_SUCCESS     If the statistics were initialized.
+ * @retval  NRF_ERROR_NULL  If a parameter is NULL.
+ */
+uint32_t ble_cscs_c_stats_init(ble_cscs_c_stats_t * p_stats);
+
+/**@brief   Function for adding a measurement to the ride statistics.
+ *
+ * @details Called by the CSC client instance for every decoded measurement.
+ *
+ * @param[in,out] p_stats   Ride statistics.
+ * @param[in]     timestamp Time stamp of the measurement, in ms.
+ * @param[in]     p_meas    Measurement with speed, cadence and distance derived.
+ */
+void ble_cscs_c_stats_update(ble_cscs_c_stats_t      * p_stats,
+                             uint32_t                  timestamp,
+                             ble_cscs_c_meas_t const * p_meas);
+
+/**@brief   Function for reading the ride statistics over a window.
+ *
+ * @param[in]  p_stats  Ride statistics.
+ * @param[in]  window   Window to read.
+ * @param[out] p_result Statistics over the window.
+ *
+ * @retval  NRF_SUCCESS             If the statistics were read.
+ * @retval  NRF_ERROR_NULL          If a parameter is NULL.
+ * @retval  NRF_ERROR_INVALID_PARAM If @p window is unknown.
+ */
+uint32_t ble_cscs_c_stats_get(ble_cscs_c_stats_t const     * p_stats,
+                              ble_cscs_c_stats_window_id_t   window,
+                              ble_cscs_c_stats_result_t    * p_result);
+
+/**@brief   Function for starting a new lap.
+ *
+ * @param[in,out] p_stats   Ride statistics.
+ *
+ * @retval  NRF_SUCCESS     If the lap was started.
+ * @retval  NRF_ERROR_NULL  If a parameter is NULL.
+ */
+uint32_t ble_cscs_c_stats_lap_reset(ble_cscs_c_stats_t * p_stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLE_CSCS_C_STATS_H__
@@ -0,0 +1,101 @@
+/* Cost of calc_update per measurement, on a ride with both counters and event times wrapping.
+ *
+ * Reports ns per sample, and cycles per sample where the time stamp counter can be read.
+ */
+#define BLE_CSCS_C_CALC_ENABLED     1
+
+#include "test_host.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLES_GET()    __rdtsc()
+#else
+#define CYCLES_GET()    0
+#endif
+
+#define SAMPLE_COUNT    4096    /**< Samples in the ride, a power of two. */
+#define PASS_COUNT      100     /**< Passes over the ride per run. */
+#define RUN_COUNT       15      /**< Runs per case; the fastest is reported. */
+
+static ble_cscs_c_meas_t m_samples[SAMPLE_COUNT];
+
+/**@brief   Function for generating a ride: 1 s notifications, speed and cadence changing slowly,
+ *          a stop every 512 samples, and counters starting close to their wraparound.
+ */
+static void ride_generate(uint8_t flags)
+{
+    uint32_t wheel_revs = 0xFFFFF000;
+    uint16_t wheel_time = 60000;
+    uint16_t crank_revs = 65000;
+    uint16_t crank_time = 30000;
+
+    memset(m_samples, 0, sizeof(m_samples));
+
+    for (uint32_t i = 0; i < SAMPLE_COUNT; i++)
+    {
+        ble_cscs_c_meas_t * p_meas  = &m_samples[i];
+        bool                stopped = (i % 512) >= 500;
+
+        if (!stopped)
+        {
+            wheel_revs += 3 + (i / 64) % 3;
+            wheel_time += 1024 - (i % 5);
+            crank_revs += 1 + (i / 128) % 2;
+            crank_time += 1024 - (i % 3);
+        }
+
+        p_meas->is_wheel_rev_data_present = (flags & CSCM_FLAG_WHEEL_PRESENT) != 0;
+        p_meas->cumulative_wheel_revs     = wheel_revs;
+        p_meas->last_wheel_event_time     = wheel_time;
+        p_meas->is_crank_rev_data_present = (flags & CSCM_FLAG_CRANK_PRESENT) != 0;
+        p_meas->cumulative_crank_revs     = crank_revs;
+        p_meas->last_crank_event_time     = crank_time;
+    }
+}
+
+int main(void)
+{
+    static char const * const names[] = {"", "wheel", "crank", "wheel+crank"};
+
+    ble_cscs_c_t      cscs_c;
+    ble_cscs_c_init_t init = {.evt_handler = NULL, .wheel_circumference = 2105};
+
+    test_client_start(&cscs_c, &init);
+
+    printf("%-12s %10s %14s\n", "flags", "ns/sample", "cycles/sample");
+
+    for (uint8_t flags = 1; flags < ARRAY_SIZE(names); flags++)
+    {
+        uint64_t best_ns     = UINT64_MAX;
+        uint64_t best_cycles = UINT64_MAX;
+        uint32_t sum         = 0;
+
+        ride_generate(flags);
+
+        for (uint32_t run = 0; run < RUN_COUNT; run++)
+        {
+            memset(&cscs_c.calc_state, 0, sizeof(cscs_c.calc_state));
+
+            uint64_t start_ns     = test_ns_get();
+            uint64_t start_cycles = CYCLES_GET();
+
+            for (uint32_t i = 0; i < PASS_COUNT * SAMPLE_COUNT; i++)
+            {
+                ble_cscs_c_meas_t meas = m_samples[i & (SAMPLE_COUNT - 1)];
+
+                calc_update(&cscs_c, &meas);
+                sum += meas.calc.speed + meas.calc.cadence;
+            }
+
+            best_cycles = MIN(best_cycles, CYCLES_GET() - start_cycles);
+            best_ns     = MIN(best_ns, test_ns_get() - start_ns);
+        }
+
+        TEST_CHECK(sum != 0);
+        printf("%-12s %10.2f %14.1f\n", names[flags],
+               (double)best_ns / (PASS_COUNT * SAMPLE_COUNT),
+               (double)best_cycles / (PASS_COUNT * SAMPLE_COUNT));
+    }
+
+    return 0;
+}
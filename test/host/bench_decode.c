@@ -0,0 +1,98 @@
+/* Cost of decoding a CSC Measurement with the table-driven csc_meas_decode and with the decoder
+ * of the original on_hvx, over a mix of all four flag combinations.
+ */
+#include "test_host.h"
+
+#define MEAS_COUNT      1024    /**< Distinct measurements, a power of two. */
+#define PASS_COUNT      200     /**< Passes over the measurements per run. */
+#define RUN_COUNT       15      /**< Runs per decoder; the fastest is reported. */
+
+typedef bool (* decode_t)(uint8_t const * p_data, uint16_t len, uint8_t flags_mask, ble_cscs_c_meas_t * p_meas);
+
+static uint8_t  m_data[MEAS_COUNT][11];
+static uint16_t m_len[MEAS_COUNT];
+
+/**@brief   Decoder of on_hvx before the layout table, as in the first commit of this module.
+ *
+ * @details It reads the fields given by the flags without checking the length of the payload.
+ */
+static bool old_decode(uint8_t const * p_data, uint16_t len, uint8_t flags_mask, ble_cscs_c_meas_t * p_meas)
+{
+    uint32_t index = 0;
+
+    p_meas->is_wheel_rev_data_present = p_data[index] & CSCM_FLAG_WHEEL_PRESENT;
+    p_meas->is_crank_rev_data_present = p_data[index] & CSCM_FLAG_CRANK_PRESENT;
+    index++;
+
+    if (p_meas->is_wheel_rev_data_present)
+    {
+        p_meas->cumulative_wheel_revs = uint32_decode(&p_data[index]);
+        index += sizeof(uint32_t);
+        p_meas->last_wheel_event_time = uint16_decode(&p_data[index]);
+        index += sizeof(uint16_t);
+    }
+    if (p_meas->is_crank_rev_data_present)
+    {
+        p_meas->cumulative_crank_revs = uint16_decode(&p_data[index]);
+        index += sizeof(uint16_t);
+        p_meas->last_crank_event_time = uint16_decode(&p_data[index]);
+        index += sizeof(uint16_t);
+    }
+
+    return true;
+}
+
+/**@brief   Function for timing a decoder.
+ *
+ * @return  Fastest time per measurement, in ns.
+ */
+static double decode_time(decode_t decode, uint32_t * p_sum)
+{
+    uint64_t best_ns = UINT64_MAX;
+
+    for (uint32_t run = 0; run < RUN_COUNT; run++)
+    {
+        uint64_t start = test_ns_get();
+        uint32_t sum   = 0;
+
+        for (uint32_t i = 0; i < PASS_COUNT * MEAS_COUNT; i++)
+        {
+            ble_cscs_c_meas_t meas;
+            uint32_t          n = i & (MEAS_COUNT - 1);
+
+            decode(m_data[n], m_len[n], CSCM_FLAG_LAYOUT_MASK, &meas);
+            sum += (meas.is_wheel_rev_data_present ? meas.cumulative_wheel_revs + meas.last_wheel_event_time : 0) +
+                   (meas.is_crank_rev_data_present ? meas.cumulative_crank_revs + meas.last_crank_event_time : 0);
+        }
+
+        best_ns  = MIN(best_ns, test_ns_get() - start);
+        *p_sum   = sum;
+    }
+
+    return (double)best_ns / (PASS_COUNT * MEAS_COUNT);
+}
+
+int main(void)
+{
+    uint32_t old_sum;
+    uint32_t new_sum;
+
+    srand(1816);
+    for (uint32_t i = 0; i < MEAS_COUNT; i++)
+    {
+        m_len[i] = test_meas_encode(m_data[i], (uint8_t)(rand() & CSCM_FLAG_LAYOUT_MASK),
+                                    (uint32_t)rand(), (uint16_t)rand(), (uint16_t)rand(), (uint16_t)rand());
+    }
+
+    double old_ns = decode_time(old_decode, &old_sum);
+    double new_ns = decode_time(csc_meas_decode, &new_sum);
+
+    // Both decoders must agree on well-formed measurements.
+    TEST_CHECK(old_sum == new_sum);
+
+    printf("%-10s %8s %14s\n", "decoder", "ns/meas", "meas/s");
+    printf("%-10s %8.2f %14.0f\n", "old", old_ns, 1e9 / old_ns);
+    printf("%-10s %8.2f %14.0f\n", "layout", new_ns, 1e9 / new_ns);
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+/* Cost per event of routing notifications to N links, with one observer per instance
+ * (BLE_CSCS_C_ARRAY_DEF) and with a single dispatch observer (BLE_CSCS_C_ARRAY_DISPATCH_DEF).
+ *
+ * The observers of each case are walked the way nrf_sdh_ble_evt_send walks the observer section,
+ * so that N can change at run time. Notifications go to the links in turn.
+ */
+#define NRF_SDH_BLE_TOTAL_LINK_COUNT    32
+
+#include "test_host.h"
+
+#define LINK_COUNT_MAX  NRF_SDH_BLE_TOTAL_LINK_COUNT
+#define EVT_COUNT       200000  /**< Events per run. */
+#define RUN_COUNT       9       /**< Runs per case; the fastest is reported. */
+
+static ble_cscs_c_t               m_instances[LINK_COUNT_MAX];
+static ble_cscs_c_dispatch_t      m_dispatch;
+static nrf_sdh_ble_evt_observer_t m_array_obs[LINK_COUNT_MAX];
+static nrf_sdh_ble_evt_observer_t m_dispatch_obs;
+static test_evt_t                 m_evts[LINK_COUNT_MAX];
+static uint32_t                   m_evt_count[LINK_COUNT_MAX];
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    m_evt_count[p_ble_cscs_c->conn_handle]++;
+}
+
+/**@brief   Function for passing an event to each observer in turn. */
+static void observers_send(nrf_sdh_ble_evt_observer_t const * p_obs, uint32_t count, ble_evt_t const * p_ble_evt)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        p_obs[i].handler(p_ble_evt, p_obs[i].p_context);
+    }
+}
+
+/**@brief   Function for timing one case.
+ *
+ * @return  Fastest time per event, in ns.
+ */
+static double evt_time(nrf_sdh_ble_evt_observer_t const * p_obs, uint32_t obs_count, uint32_t link_count)
+{
+    uint64_t best_ns = UINT64_MAX;
+
+    for (uint32_t run = 0; run < RUN_COUNT; run++)
+    {
+        uint64_t start = test_ns_get();
+
+        for (uint32_t i = 0; i < EVT_COUNT; i++)
+        {
+            observers_send(p_obs, obs_count, &m_evts[i % link_count].evt);
+        }
+
+        best_ns = MIN(best_ns, test_ns_get() - start);
+    }
+
+    return (double)best_ns / EVT_COUNT;
+}
+
+int main(void)
+{
+    uint8_t data[11];
+    uint16_t len = test_meas_encode(data, 0x03, 1000, 2048, 100, 1024);
+
+    printf("%5s %14s %14s\n", "links", "array ns/evt", "dispatch ns/evt");
+
+    for (uint32_t link_count = 1; link_count <= LINK_COUNT_MAX; link_count *= 2)
+    {
+        memset(m_evt_count, 0, sizeof(m_evt_count));
+        memset(&m_dispatch, 0, sizeof(m_dispatch));
+        m_dispatch.p_instances = m_instances;
+        m_dispatch.count       = (uint8_t)link_count;
+
+        // Connection handles are assigned in reverse, so that link i is not served by instance i.
+        for (uint32_t i = 0; i < link_count; i++)
+        {
+            ble_cscs_c_init_t init = {.evt_handler = evt_handler, .p_gatt_queue = &test_gatt_queue};
+            ble_cscs_c_db_t   db;
+
+            test_db_get(&db);
+            TEST_CHECK(ble_cscs_c_init(&m_instances[i], &init) == NRF_SUCCESS);
+            TEST_CHECK(ble_cscs_c_handles_assign(&m_instances[i], (uint16_t)(link_count - 1 - i), &db) == NRF_SUCCESS);
+
+            m_array_obs[i].handler   = ble_cscs_c_on_ble_evt;
+            m_array_obs[i].p_context = &m_instances[i];
+
+            test_hvx_build(&m_evts[i], (uint16_t)i, TEST_CSCM_HANDLE, data, len);
+        }
+        m_dispatch_obs.handler   = ble_cscs_c_dispatch_on_ble_evt;
+        m_dispatch_obs.p_context = &m_dispatch;
+
+        double array_ns    = evt_time(m_array_obs, link_count, link_count);
+        double dispatch_ns = evt_time(&m_dispatch_obs, 1, link_count);
+
+        // Each event reached exactly the instance of its link, in both cases.
+        for (uint32_t i = 0; i < link_count; i++)
+        {
+            TEST_CHECK(m_evt_count[i] == 2 * RUN_COUNT * (EVT_COUNT / link_count));
+        }
+
+        printf("%5u %14.1f %14.1f\n", (unsigned)link_count, array_ns, dispatch_ns);
+    }
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+/* Cost of a CSC Measurement notification delivered decoded (BLE_CSCS_C_EVT_CSM_NOTIFICATION) and
+ * undecoded (BLE_CSCS_C_EVT_CSM_VIEW), for each combination of the Wheel and Crank Revolution
+ * Data Present flags.
+ *
+ * In both modes the handler reads every field present, so the view pays for its accessors. The
+ * view is also measured with a handler that reads nothing, as for a measurement only forwarded.
+ * Add -DBLE_CSCS_C_<OPTION>_ENABLED=1 to CFLAGS to see what eager decoding costs with an option on.
+ */
+#define BLE_CSCS_C_MEAS_VIEW_ENABLED    1
+
+#include "test_host.h"
+
+#define NOTIF_COUNT     200000  /**< Notifications per run. */
+#define RUN_COUNT       15      /**< Runs per case; the fastest is reported. */
+
+/**@brief   Ways the measurement reaches the handler. */
+typedef enum
+{
+    MODE_EAGER,         /**< Decoded by the module. */
+    MODE_VIEW,          /**< Undecoded, every field read with the accessors. */
+    MODE_VIEW_UNREAD,   /**< Undecoded, no field read. */
+    MODE_COUNT
+} mode_t;
+
+static mode_t            m_mode;
+static volatile uint32_t m_sum;
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    uint32_t wheel_revs = 0;
+    uint16_t wheel_time = 0;
+    uint16_t crank_revs = 0;
+    uint16_t crank_time = 0;
+
+    switch (m_mode)
+    {
+        case MODE_EAGER:
+            TEST_CHECK(p_evt->evt_type == BLE_CSCS_C_EVT_CSM_NOTIFICATION);
+            if (p_evt->params.csc.is_wheel_rev_data_present)
+            {
+                wheel_revs = p_evt->params.csc.cumulative_wheel_revs;
+                wheel_time = p_evt->params.csc.last_wheel_event_time;
+            }
+            if (p_evt->params.csc.is_crank_rev_data_present)
+            {
+                crank_revs = p_evt->params.csc.cumulative_crank_revs;
+                crank_time = p_evt->params.csc.last_crank_event_time;
+            }
+            break;
+
+        case MODE_VIEW:
+            TEST_CHECK(p_evt->evt_type == BLE_CSCS_C_EVT_CSM_VIEW);
+            (void)ble_cscs_c_meas_view_wheel_get(&p_evt->params.csc_view, &wheel_revs, &wheel_time);
+            (void)ble_cscs_c_meas_view_crank_get(&p_evt->params.csc_view, &crank_revs, &crank_time);
+            break;
+
+        default:
+            break;
+    }
+
+    m_sum += 1 + wheel_revs + wheel_time + crank_revs + crank_time;
+}
+
+int main(void)
+{
+    static char const * const names[] = {"none", "wheel", "crank", "wheel+crank"};
+
+    ble_cscs_c_t      cscs_c;
+    ble_cscs_c_init_t init = {.evt_handler = evt_handler};
+
+    test_client_start(&cscs_c, &init);
+
+    printf("%-12s %14s %14s %14s\n", "flags", "eager ns/notif", "view ns/notif", "unread ns/notif");
+
+    for (uint8_t flags = 0; flags < ARRAY_SIZE(names); flags++)
+    {
+        test_evt_t evt[2];
+        uint8_t    data[11];
+        double     ns_per_notif[MODE_COUNT];
+
+        // Alternate two measurements one wheel and one crank revolution apart.
+        for (uint32_t i = 0; i < ARRAY_SIZE(evt); i++)
+        {
+            uint16_t len = test_meas_encode(data, flags, 1000 + i, (uint16_t)(1024 * i), 100 + i, (uint16_t)(1024 * i));
+
+            test_hvx_build(&evt[i], TEST_CONN_HANDLE, TEST_CSCM_HANDLE, data, len);
+        }
+
+        for (m_mode = MODE_EAGER; m_mode < MODE_COUNT; m_mode++)
+        {
+            uint64_t best_ns = UINT64_MAX;
+
+            cscs_c.meas_view = (m_mode != MODE_EAGER);
+
+            for (uint32_t run = 0; run < RUN_COUNT; run++)
+            {
+                uint64_t start = test_ns_get();
+
+                for (uint32_t i = 0; i < NOTIF_COUNT; i++)
+                {
+                    ble_cscs_c_on_ble_evt(&evt[i & 1].evt, &cscs_c);
+                }
+
+                best_ns = MIN(best_ns, test_ns_get() - start);
+            }
+
+            ns_per_notif[m_mode] = (double)best_ns / NOTIF_COUNT;
+        }
+
+        printf("%-12s %14.1f %14.1f %14.1f\n", names[flags],
+               ns_per_notif[MODE_EAGER], ns_per_notif[MODE_VIEW], ns_per_notif[MODE_VIEW_UNREAD]);
+    }
+
+    TEST_CHECK(m_sum != 0);
+
+    return 0;
+}
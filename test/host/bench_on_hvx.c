@@ -0,0 +1,63 @@
+/* Cost of ble_cscs_c_on_ble_evt for a CSC Measurement notification, for each combination of
+ * the Wheel and Crank Revolution Data Present flags.
+ *
+ * Builds with every option off; add -DBLE_CSCS_C_<OPTION>_ENABLED=1 to CFLAGS to measure one.
+ */
+#include "test_host.h"
+
+#define NOTIF_COUNT     200000  /**< Notifications per run. */
+#define RUN_COUNT       15      /**< Runs per flag combination; the fastest is reported. */
+
+static volatile uint32_t m_evt_count;
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    m_evt_count++;
+}
+
+int main(void)
+{
+    static char const * const names[] = {"none", "wheel", "crank", "wheel+crank"};
+
+    ble_cscs_c_t      cscs_c;
+    ble_cscs_c_init_t init = {.evt_handler = evt_handler};
+
+    test_client_start(&cscs_c, &init);
+
+    printf("%-12s %8s %14s\n", "flags", "ns/notif", "events/s");
+
+    for (uint8_t flags = 0; flags < ARRAY_SIZE(names); flags++)
+    {
+        test_evt_t evt[2];
+        uint8_t    data[11];
+        uint64_t   best_ns = UINT64_MAX;
+
+        // Alternate two measurements one wheel and one crank revolution apart.
+        for (uint32_t i = 0; i < ARRAY_SIZE(evt); i++)
+        {
+            uint16_t len = test_meas_encode(data, flags, 1000 + i, (uint16_t)(1024 * i), 100 + i, (uint16_t)(1024 * i));
+
+            test_hvx_build(&evt[i], TEST_CONN_HANDLE, TEST_CSCM_HANDLE, data, len);
+        }
+
+        for (uint32_t run = 0; run < RUN_COUNT; run++)
+        {
+            uint64_t start = test_ns_get();
+
+            for (uint32_t i = 0; i < NOTIF_COUNT; i++)
+            {
+                ble_cscs_c_on_ble_evt(&evt[i & 1].evt, &cscs_c);
+            }
+
+            best_ns = MIN(best_ns, test_ns_get() - start);
+        }
+
+        double ns_per_notif = (double)best_ns / NOTIF_COUNT;
+
+        printf("%-12s %8.1f %14.0f\n", names[flags], ns_per_notif, 1e9 / ns_per_notif);
+    }
+
+    TEST_CHECK(m_evt_count == (uint32_t)ARRAY_SIZE(names) * RUN_COUNT * NOTIF_COUNT);
+
+    return 0;
+}
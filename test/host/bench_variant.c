@@ -0,0 +1,57 @@
+/* Row of the variant table of the README: code size of ble_cscs_c.c and cost of
+ * ble_cscs_c_on_ble_evt for a notification with the data the variant decodes.
+ *
+ * Built once per variant by "make variants", with the -D flags of the variant and every option
+ * off. The code size is measured by the Makefile and passed on the command line.
+ */
+#include "test_host.h"
+
+#define NOTIF_COUNT     1000000 /**< Notifications per run. */
+#define RUN_COUNT       31      /**< Runs; the fastest is reported. */
+
+static volatile uint32_t m_evt_count;
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    m_evt_count++;
+}
+
+int main(int argc, char * argv[])
+{
+    ble_cscs_c_t      cscs_c;
+    ble_cscs_c_init_t init    = {.evt_handler = evt_handler};
+    test_evt_t        evt[2];
+    uint8_t           data[11];
+    uint64_t          best_ns = UINT64_MAX;
+
+    TEST_CHECK(argc == 3);
+
+    test_client_start(&cscs_c, &init);
+
+    // Alternate two measurements one wheel and one crank revolution apart.
+    for (uint32_t i = 0; i < ARRAY_SIZE(evt); i++)
+    {
+        uint16_t len = test_meas_encode(data, CSCM_FLAG_SUPPORTED_MASK,
+                                        1000 + i, (uint16_t)(1024 * i), 100 + i, (uint16_t)(1024 * i));
+
+        test_hvx_build(&evt[i], TEST_CONN_HANDLE, TEST_CSCM_HANDLE, data, len);
+    }
+
+    for (uint32_t run = 0; run < RUN_COUNT; run++)
+    {
+        uint64_t start = test_ns_get();
+
+        for (uint32_t i = 0; i < NOTIF_COUNT; i++)
+        {
+            ble_cscs_c_on_ble_evt(&evt[i & 1].evt, &cscs_c);
+        }
+
+        best_ns = MIN(best_ns, test_ns_get() - start);
+    }
+
+    TEST_CHECK(m_evt_count == RUN_COUNT * NOTIF_COUNT);
+
+    printf("| %-10s | %-14s | %-24.1f |\n", argv[1], argv[2], (double)best_ns / NOTIF_COUNT);
+
+    return 0;
+}
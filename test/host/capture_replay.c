@@ -0,0 +1,203 @@
+/* Replays a capture made with BLE_CSCS_C_CAPTURE through ble_cscs_c_on_ble_evt.
+ *
+ *   capture_replay [-r] [-d] [-l loops] [-w circumference] [-H handle] file
+ *
+ *   -r  replay in real time, following the time stamps of the records; default is maximum speed
+ *   -d  print every measurement delivered, for comparing against a reference output
+ *   -l  replay the file this many times, for timing
+ *   -w  wheel circumference in mm, default 2105
+ *   -H  handle of the CSC Measurement, default the attribute handle of the first record
+ *
+ * The file is the byte stream read with ble_cscs_c_capture_read. The link is the connection handle
+ * of the first record. A summary with the throughput is printed to stderr.
+ */
+#define BLE_CSCS_C_CALC_ENABLED     1
+#define BLE_CSCS_C_COUNTERS_ENABLED 1
+#define BLE_CSCS_C_CAPTURE_ENABLED  1
+
+#include <unistd.h>
+#include "test_host.h"
+
+#define PAYLOAD_MAX     UINT8_MAX
+
+/**@brief   BLE event with room for the largest captured payload. */
+typedef union
+{
+    ble_evt_t evt;
+    uint8_t   raw[sizeof(ble_evt_t) + PAYLOAD_MAX];
+} replay_evt_t;
+
+static ble_cscs_c_t m_cscs_c;
+static bool         m_dump;
+static uint32_t     m_meas_count;
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    if (p_evt->evt_type != BLE_CSCS_C_EVT_CSM_NOTIFICATION)
+    {
+        return;
+    }
+
+    ble_cscs_c_meas_t const * p_meas = &p_evt->params.csc;
+
+    m_meas_count++;
+
+    if (m_dump)
+    {
+        printf("%8u", (unsigned)test_now_ms);
+        if (p_meas->is_wheel_rev_data_present)
+        {
+            printf(" wheel %10u %5u speed %5u mm/s distance %5u m", (unsigned)p_meas->cumulative_wheel_revs,
+                   p_meas->last_wheel_event_time, (unsigned)p_meas->calc.speed, (unsigned)p_meas->calc.distance);
+        }
+        if (p_meas->is_crank_rev_data_present)
+        {
+            printf(" crank %5u %5u cadence %4u.%u rpm", p_meas->cumulative_crank_revs,
+                   p_meas->last_crank_event_time, p_meas->calc.cadence / 10, p_meas->calc.cadence % 10);
+        }
+        printf("\n");
+    }
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: capture_replay [-r] [-d] [-l loops] [-w circumference] [-H handle] file\n");
+    exit(EXIT_FAILURE);
+}
+
+static uint8_t * file_read(char const * p_path, uint32_t * p_len)
+{
+    FILE    * p_file = fopen(p_path, "rb");
+    uint8_t * p_data;
+    long      len;
+
+    if ((p_file == NULL) || (fseek(p_file, 0, SEEK_END) != 0) || ((len = ftell(p_file)) < 0))
+    {
+        fprintf(stderr, "capture_replay: cannot read %s\n", p_path);
+        exit(EXIT_FAILURE);
+    }
+
+    p_data = malloc((size_t)len + 1);
+    rewind(p_file);
+    TEST_CHECK((p_data != NULL) && (fread(p_data, 1, (size_t)len, p_file) == (size_t)len));
+    fclose(p_file);
+
+    *p_len = (uint32_t)len;
+
+    return p_data;
+}
+
+static void sleep_until_ns(uint64_t deadline_ns)
+{
+    uint64_t now_ns = test_ns_get();
+
+    if (deadline_ns > now_ns)
+    {
+        struct timespec ts = {.tv_sec  = (time_t)((deadline_ns - now_ns) / 1000000000u),
+                              .tv_nsec = (long)((deadline_ns - now_ns) % 1000000000u)};
+
+        nanosleep(&ts, NULL);
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    bool      real_time     = false;
+    uint32_t  loops         = 1;
+    uint16_t  circumference = 2105;
+    long      handle        = -1;
+    uint32_t  len;
+    uint32_t  record_count  = 0;
+    int       opt;
+
+    while ((opt = getopt(argc, argv, "rdl:w:H:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'r': real_time     = true;                                 break;
+            case 'd': m_dump        = true;                                 break;
+            case 'l': loops         = (uint32_t)strtoul(optarg, NULL, 0);   break;
+            case 'w': circumference = (uint16_t)strtoul(optarg, NULL, 0);   break;
+            case 'H': handle        = strtol(optarg, NULL, 0);              break;
+            default:  usage();                                              break;
+        }
+    }
+    if ((optind != argc - 1) || (loops == 0))
+    {
+        usage();
+    }
+
+    uint8_t * p_data = file_read(argv[optind], &len);
+
+    if (len < BLE_CSCS_C_CAPTURE_HEADER_LEN)
+    {
+        fprintf(stderr, "capture_replay: %s holds no record\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    ble_cscs_c_init_t init = {.evt_handler         = evt_handler,
+                              .timestamp_get       = test_timestamp_get,
+                              .wheel_circumference = circumference,
+                              .p_gatt_queue        = &test_gatt_queue};
+    ble_cscs_c_db_t   db;
+
+    memset(&db, 0, sizeof(db));
+    db.cscs_handle = (handle >= 0) ? (uint16_t)handle : uint16_decode(&p_data[7]);
+
+    TEST_CHECK(ble_cscs_c_init(&m_cscs_c, &init) == NRF_SUCCESS);
+    TEST_CHECK(ble_cscs_c_handles_assign(&m_cscs_c, uint16_decode(&p_data[5]), &db) == NRF_SUCCESS);
+
+    uint64_t start_ns      = test_ns_get();
+    uint32_t first_time_ms = uint32_decode(&p_data[1]);
+
+    for (uint32_t loop = 0; loop < loops; loop++)
+    {
+        uint32_t offset = 0;
+
+        while (offset + BLE_CSCS_C_CAPTURE_HEADER_LEN <= len)
+        {
+            uint8_t const * p_rec = &p_data[offset];
+            replay_evt_t    evt;
+
+            if (offset + BLE_CSCS_C_CAPTURE_HEADER_LEN + p_rec[0] > len)
+            {
+                fprintf(stderr, "capture_replay: record at offset %u is truncated\n", (unsigned)offset);
+                return EXIT_FAILURE;
+            }
+
+            test_now_ms = uint32_decode(&p_rec[1]);
+            if (real_time)
+            {
+                sleep_until_ns(start_ns + (uint64_t)(test_now_ms - first_time_ms) * 1000000u);
+            }
+
+            memset(&evt, 0, sizeof(ble_evt_t));
+            evt.evt.header.evt_id                   = BLE_GATTC_EVT_HVX;
+            evt.evt.evt.gattc_evt.conn_handle       = uint16_decode(&p_rec[5]);
+            evt.evt.evt.gattc_evt.params.hvx.handle = uint16_decode(&p_rec[7]);
+            evt.evt.evt.gattc_evt.params.hvx.type   = BLE_GATT_HVX_NOTIFICATION;
+            evt.evt.evt.gattc_evt.params.hvx.len    = p_rec[0];
+            memcpy(evt.evt.evt.gattc_evt.params.hvx.data, &p_rec[BLE_CSCS_C_CAPTURE_HEADER_LEN], p_rec[0]);
+
+            ble_cscs_c_on_ble_evt(&evt.evt, &m_cscs_c);
+
+            offset += BLE_CSCS_C_CAPTURE_HEADER_LEN + p_rec[0];
+            record_count++;
+        }
+    }
+
+    uint64_t              elapsed_ns = test_ns_get() - start_ns;
+    ble_cscs_c_counters_t counters;
+
+    TEST_CHECK(ble_cscs_c_counters_get(&m_cscs_c, &counters) == NRF_SUCCESS);
+
+    fprintf(stderr, "%u records: %u measurements, %u malformed, %u on another handle, %u on another link\n",
+            (unsigned)record_count, (unsigned)m_meas_count, (unsigned)counters.malformed_count,
+            (unsigned)counters.wrong_handle_count, (unsigned)counters.wrong_conn_count);
+    fprintf(stderr, "%.1f ns/record, %.0f records/s\n",
+            (double)elapsed_ns / record_count, record_count * 1e9 / (double)elapsed_ns);
+
+    free(p_data);
+
+    return 0;
+}
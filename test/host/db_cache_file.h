@@ -0,0 +1,154 @@
+/* Discovered handle cache backend for the host: a table in RAM, written to a file on every change
+ * so that a later run, standing in for a reboot, can load it again.
+ *
+ * Include after test_host.h in a build with BLE_CSCS_C_DB_CACHE_ENABLED.
+ */
+#ifndef DB_CACHE_FILE_H__
+#define DB_CACHE_FILE_H__
+
+#define DB_CACHE_FILE_PEER_COUNT    8   /**< Number of peers kept in the table. */
+
+/**@brief   Entry of the cache table. */
+typedef struct
+{
+    bool            is_valid;
+    ble_gap_addr_t  peer_addr;
+    ble_cscs_c_db_t peer_db;
+} db_cache_file_entry_t;
+
+/**@brief   State of the backend. */
+typedef struct
+{
+    char const          * p_path;       /**< File the table is written to, or NULL to keep it in RAM only. */
+    db_cache_file_entry_t entries[DB_CACHE_FILE_PEER_COUNT];
+    uint32_t              load_count;   /**< Calls to load. */
+    uint32_t              store_count;  /**< Calls to store. */
+    uint32_t              erase_count;  /**< Calls to erase. */
+} db_cache_file_t;
+
+static db_cache_file_t m_db_cache_file;
+
+static db_cache_file_entry_t * db_cache_file_find(ble_gap_addr_t const * p_peer_addr)
+{
+    for (uint32_t i = 0; i < DB_CACHE_FILE_PEER_COUNT; i++)
+    {
+        db_cache_file_entry_t * p_entry = &m_db_cache_file.entries[i];
+
+        if (p_entry->is_valid &&
+            (p_entry->peer_addr.addr_type == p_peer_addr->addr_type) &&
+            (memcmp(p_entry->peer_addr.addr, p_peer_addr->addr, BLE_GAP_ADDR_LEN) == 0))
+        {
+            return p_entry;
+        }
+    }
+
+    return NULL;
+}
+
+static uint32_t db_cache_file_write(void)
+{
+    if (m_db_cache_file.p_path == NULL)
+    {
+        return NRF_SUCCESS;
+    }
+
+    FILE * p_file = fopen(m_db_cache_file.p_path, "wb");
+
+    if (p_file == NULL)
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+
+    size_t written = fwrite(m_db_cache_file.entries, sizeof(m_db_cache_file.entries), 1, p_file);
+
+    return ((fclose(p_file) == 0) && (written == 1)) ? NRF_SUCCESS : NRF_ERROR_INTERNAL;
+}
+
+static uint32_t db_cache_file_load(ble_gap_addr_t const * p_peer_addr, ble_cscs_c_db_t * p_peer_db)
+{
+    db_cache_file_entry_t const * p_entry = db_cache_file_find(p_peer_addr);
+
+    m_db_cache_file.load_count++;
+
+    if (p_entry == NULL)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    *p_peer_db = p_entry->peer_db;
+
+    return NRF_SUCCESS;
+}
+
+static uint32_t db_cache_file_store(ble_gap_addr_t const * p_peer_addr, ble_cscs_c_db_t const * p_peer_db)
+{
+    db_cache_file_entry_t * p_entry = db_cache_file_find(p_peer_addr);
+
+    m_db_cache_file.store_count++;
+
+    for (uint32_t i = 0; (p_entry == NULL) && (i < DB_CACHE_FILE_PEER_COUNT); i++)
+    {
+        if (!m_db_cache_file.entries[i].is_valid)
+        {
+            p_entry = &m_db_cache_file.entries[i];
+        }
+    }
+
+    if (p_entry == NULL)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    p_entry->is_valid  = true;
+    p_entry->peer_addr = *p_peer_addr;
+    p_entry->peer_db   = *p_peer_db;
+
+    return db_cache_file_write();
+}
+
+static uint32_t db_cache_file_erase(ble_gap_addr_t const * p_peer_addr)
+{
+    db_cache_file_entry_t * p_entry = db_cache_file_find(p_peer_addr);
+
+    m_db_cache_file.erase_count++;
+
+    if (p_entry == NULL)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    p_entry->is_valid = false;
+
+    return db_cache_file_write();
+}
+
+static ble_cscs_c_db_cache_t const db_cache_file =
+{
+    .load  = db_cache_file_load,
+    .store = db_cache_file_store,
+    .erase = db_cache_file_erase
+};
+
+/**@brief   Function for starting the backend, as after a reboot.
+ *
+ * @param[in] p_path    File holding the table, or NULL to keep it in RAM only. The table is loaded
+ *                      from the file if it exists, and is empty otherwise.
+ */
+static inline void db_cache_file_open(char const * p_path)
+{
+    memset(&m_db_cache_file, 0, sizeof(m_db_cache_file));
+    m_db_cache_file.p_path = p_path;
+
+    FILE * p_file = (p_path != NULL) ? fopen(p_path, "rb") : NULL;
+
+    if (p_file != NULL)
+    {
+        if (fread(m_db_cache_file.entries, sizeof(m_db_cache_file.entries), 1, p_file) != 1)
+        {
+            memset(m_db_cache_file.entries, 0, sizeof(m_db_cache_file.entries));
+        }
+        fclose(p_file);
+    }
+}
+
+#endif // DB_CACHE_FILE_H__
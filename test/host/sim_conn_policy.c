@@ -0,0 +1,243 @@
+/* Connection events per minute and delivery latency added by the connection interval, under a
+ * commute with a stop at a traffic light and a parked period, with fixed connection parameters
+ * and with the connection policy.
+ *
+ * The sensor notifies at its rate, with a few ms of jitter, while it is awake, with unchanged
+ * counters when the rider stands still, and stops notifying a minute after the wheel stopped. A notification is delivered
+ * in the first connection event after it is sent. New connection parameters apply six connection
+ * events after they were requested, as with the connection parameter update procedure.
+ */
+#define BLE_CSCS_C_CONN_POLICY_ENABLED  1
+
+#include "test_host.h"
+
+// Both modules register a log module of their own.
+#undef NRF_LOG_MODULE_NAME
+#include "ble_cscs_c_conn_policy.c"
+
+#define UNIT_1_25_MS            1.25    /**< Unit of the connection interval. */
+#define ACTIVE_INTERVAL         24      /**< Connection interval while moving, in 1.25 ms units. */
+#define IDLE_INTERVAL           800     /**< Connection interval while idle, in 1.25 ms units. */
+#define IDLE_TIMEOUT_MS         3000    /**< Time without a new revolution after which the rider is idle. */
+#define ACTIVE_COUNT            2       /**< Measurements with a new revolution after which the rider is moving. */
+#define UPDATE_INSTANT_EVENTS   6       /**< Connection events between a request and the new parameters. */
+#define SENSOR_AWAKE_MS         60000   /**< Time the sensor keeps notifying after the wheel stopped. */
+#define PROCESS_INTERVAL_MS     1000    /**< Interval of the call to ble_cscs_c_conn_policy_process. */
+
+/**@brief   Part of a ride. */
+typedef struct
+{
+    char const * p_name;
+    uint32_t     duration_ms;
+    bool         is_moving;
+} segment_t;
+
+/**@brief   Connection parameters used in a run. */
+typedef enum
+{
+    MODE_ACTIVE,        /**< Active parameters all the time. */
+    MODE_IDLE,          /**< Idle parameters all the time. */
+    MODE_POLICY,        /**< Parameters chosen by the connection policy. */
+    MODE_COUNT
+} mode_t;
+
+/**@brief   Results of a run. */
+typedef struct
+{
+    uint32_t conn_events;
+    uint32_t notif_count;
+    uint64_t latency_sum_ms;
+    uint32_t latency_max_ms;
+    uint32_t moving_count;
+    uint64_t moving_latency_sum_ms;
+    uint32_t moving_latency_max_ms;
+} result_t;
+
+static segment_t const m_commute[] =
+{
+    {"ride",          8 * 60000, true},
+    {"traffic light",     45000, false},
+    {"ride",         12 * 60000, true},
+    {"parked",       20 * 60000, false},
+    {"ride",         10 * 60000, true},
+};
+
+static ble_gap_conn_params_t const m_active_params = {ACTIVE_INTERVAL, ACTIVE_INTERVAL, 0, 400};
+static ble_gap_conn_params_t const m_idle_params   = {IDLE_INTERVAL, IDLE_INTERVAL, 0, 600};
+
+static ble_cscs_c_t             m_cscs_c;
+static ble_cscs_c_conn_policy_t m_policy;
+static uint16_t                 m_requested_interval;   /**< Interval of the last request, 0 if none is pending. */
+static uint32_t                 m_request_count;
+
+/**@brief   GAP backend: records the request, which the simulated link applies later. */
+static uint32_t conn_param_update(uint16_t conn_handle, ble_gap_conn_params_t const * p_conn_params)
+{
+    TEST_CHECK(conn_handle == TEST_CONN_HANDLE);
+
+    m_requested_interval = p_conn_params->max_conn_interval;
+    m_request_count++;
+
+    return NRF_SUCCESS;
+}
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+}
+
+static result_t ride_simulate(mode_t mode, uint32_t notif_interval_ms)
+{
+    ble_cscs_c_conn_policy_config_t config = {.active_params     = m_active_params,
+                                              .idle_params       = m_idle_params,
+                                              .idle_timeout      = IDLE_TIMEOUT_MS,
+                                              .active_count      = ACTIVE_COUNT,
+                                              .conn_param_update = conn_param_update};
+    ble_cscs_c_init_t               init   = {.evt_handler   = evt_handler,
+                                              .timestamp_get = test_timestamp_get};
+    result_t                        result;
+
+    srand(notif_interval_ms);
+    memset(&result, 0, sizeof(result));
+    m_requested_interval = 0;
+    m_request_count      = 0;
+
+    if (mode == MODE_POLICY)
+    {
+        TEST_CHECK(ble_cscs_c_conn_policy_init(&m_policy, &config) == NRF_SUCCESS);
+        init.p_conn_policy = &m_policy;
+    }
+    test_now_ms = 0;
+    test_client_start(&m_cscs_c, &init);
+
+    uint16_t interval         = (mode == MODE_IDLE) ? IDLE_INTERVAL : ACTIVE_INTERVAL;
+    double   next_event_ms    = 0;
+    uint32_t instant_left     = 0;
+    uint32_t next_notif_ms    = 500;
+    uint32_t stopped_ms       = 0;
+    uint32_t wheel_revs       = 0;
+    bool     is_notif_pending = false;
+    bool     is_notif_moving  = false;
+    uint32_t notif_sent_ms    = 0;
+    uint32_t segment_end_ms   = 0;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_commute); i++)
+    {
+        segment_t const * p_segment = &m_commute[i];
+
+        segment_end_ms += p_segment->duration_ms;
+
+        for (; test_now_ms < segment_end_ms; test_now_ms++)
+        {
+            if (p_segment->is_moving)
+            {
+                stopped_ms = test_now_ms;
+            }
+
+            // The sensor sleeps a while after the wheel stopped, and wakes when it turns again.
+            if ((test_now_ms >= next_notif_ms) && ((test_now_ms - stopped_ms) < SENSOR_AWAKE_MS))
+            {
+                wheel_revs      += p_segment->is_moving ? 3 : 0;
+                is_notif_pending = true;
+                is_notif_moving  = p_segment->is_moving;
+                notif_sent_ms    = test_now_ms;
+                next_notif_ms    = test_now_ms + notif_interval_ms - 5 + (uint32_t)rand() % 11;
+            }
+            else if (test_now_ms >= next_notif_ms)
+            {
+                next_notif_ms = test_now_ms + 1;
+            }
+
+            if (test_now_ms >= next_event_ms)
+            {
+                result.conn_events++;
+
+                if (is_notif_pending)
+                {
+                    uint32_t latency = test_now_ms - notif_sent_ms;
+                    uint8_t  data[11];
+
+                    result.notif_count++;
+                    result.latency_sum_ms += latency;
+                    result.latency_max_ms  = MAX(result.latency_max_ms, latency);
+                    if (is_notif_moving)
+                    {
+                        result.moving_count++;
+                        result.moving_latency_sum_ms += latency;
+                        result.moving_latency_max_ms  = MAX(result.moving_latency_max_ms, latency);
+                    }
+
+                    test_hvx_send(&m_cscs_c, data, test_meas_encode(data, 0x01, wheel_revs, 0, 0, 0));
+                    is_notif_pending = false;
+                }
+
+                if (m_requested_interval != 0)
+                {
+                    if (instant_left == 0)
+                    {
+                        instant_left = UPDATE_INSTANT_EVENTS;
+                    }
+                    if (--instant_left == 0)
+                    {
+                        interval             = m_requested_interval;
+                        m_requested_interval = 0;
+                    }
+                }
+
+                next_event_ms += interval * UNIT_1_25_MS;
+            }
+
+            if ((mode == MODE_POLICY) && ((test_now_ms % PROCESS_INTERVAL_MS) == 0))
+            {
+                ble_cscs_c_conn_policy_process(&m_policy, TEST_CONN_HANDLE, test_now_ms);
+            }
+        }
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    static char const * const names[]           = {"fixed active", "fixed idle", "policy"};
+    static uint32_t const     notif_intervals[] = {1000, 4000};
+
+    uint32_t duration_ms = 0;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_commute); i++)
+    {
+        duration_ms += m_commute[i].duration_ms;
+    }
+
+    printf("commute of %.2f min: ride 8 min, traffic light 45 s, ride 12 min, parked 20 min, ride 10 min\n",
+           duration_ms / 60000.0);
+    printf("connection interval %.0f ms active, %.0f ms idle, idle after %u ms without a revolution\n",
+           ACTIVE_INTERVAL * UNIT_1_25_MS, IDLE_INTERVAL * UNIT_1_25_MS, IDLE_TIMEOUT_MS);
+    printf("%-8s %-13s %11s %8s %11s %11s %16s %16s\n", "sensor", "parameters", "events/min", "updates",
+           "latency avg", "latency max", "moving avg (ms)", "moving max (ms)");
+
+    for (uint32_t n = 0; n < ARRAY_SIZE(notif_intervals); n++)
+    {
+        for (mode_t mode = MODE_ACTIVE; mode < MODE_COUNT; mode++)
+        {
+            result_t result = ride_simulate(mode, notif_intervals[n]);
+
+            TEST_CHECK(result.notif_count > 0);
+
+            printf("%5u ms %-13s %11.1f %8u %11.1f %11u %16.1f %16u\n",
+                   (unsigned)notif_intervals[n], names[mode], result.conn_events * 60000.0 / duration_ms,
+                   (unsigned)m_request_count, (double)result.latency_sum_ms / result.notif_count,
+                   (unsigned)result.latency_max_ms,
+                   (double)result.moving_latency_sum_ms / result.moving_count,
+                   (unsigned)result.moving_latency_max_ms);
+
+            if (mode == MODE_POLICY)
+            {
+                // Idle at the light and when parked, active again after each: no switching back
+                // and forth while riding, whatever the rate of the sensor.
+                TEST_CHECK(m_request_count == 4);
+            }
+        }
+    }
+
+    return 0;
+}
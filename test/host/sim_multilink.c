@@ -0,0 +1,297 @@
+/* N virtual sensors connecting, being discovered, notifying and disconnecting, with every event
+ * passed through the SoftDevice observer loop to BLE_CSCS_C_ARRAY_DEF instances.
+ *
+ * Each peer has a profile (wheel, crank or both), a notification interval with jitter, and
+ * sessions of random length separated by reconnections. For N = 1..32 peers the simulation
+ * reports the events per second of wall time, the time from passing a notification to the
+ * observers to the application callback of its link (p50 of the median link, p99 of the worst
+ * link, both including one clock read), and the process CPU time.
+ */
+#define NRF_SDH_BLE_TOTAL_LINK_COUNT    32
+
+#include "test_host.h"
+
+#define PEER_COUNT_MAX      NRF_SDH_BLE_TOTAL_LINK_COUNT
+#define SIM_DURATION_MS     (600 * 1000)    /**< Simulated time per run. */
+#define CONN_INTERVAL_MS    30              /**< Connection interval of every link. */
+#define DISC_DURATION_MS    (7 * CONN_INTERVAL_MS)  /**< Database Discovery of the CSC Service. */
+#define SESSION_MIN_MS      (60 * 1000)     /**< Shortest connection. */
+#define SESSION_MAX_MS      (240 * 1000)    /**< Longest connection. */
+#define RECONNECT_MIN_MS    2000            /**< Shortest time before a peer connects again. */
+#define RECONNECT_MAX_MS    10000           /**< Longest time before a peer connects again. */
+#define LATENCY_SAMPLES_MAX 4096            /**< Latencies kept per link. */
+
+/**@brief   State of a virtual peer. */
+typedef enum
+{
+    PEER_IDLE,          /**< Not connected; connects at @p next_ms. */
+    PEER_DISCOVERING,   /**< Connected; discovery completes at @p next_ms. */
+    PEER_NOTIFYING      /**< Notifications enabled; the next one is sent at @p next_ms. */
+} peer_state_t;
+
+/**@brief   Virtual peer. */
+typedef struct
+{
+    uint8_t      flags;             /**< Flags of its measurements. */
+    uint32_t     interval_ms;       /**< Notification interval. */
+    uint32_t     jitter_ms;         /**< Largest deviation from @p interval_ms. */
+    peer_state_t state;
+    uint32_t     next_ms;           /**< Time of the next event of the peer. */
+    uint32_t     disconnect_ms;     /**< End of the current session. */
+    uint32_t     wheel_revs;
+    uint16_t     wheel_time;
+    uint16_t     crank_revs;
+    uint16_t     crank_time;
+} peer_t;
+
+/**@brief   Latencies of one link. */
+typedef struct
+{
+    uint32_t count;
+    uint32_t ns[LATENCY_SAMPLES_MAX];
+} latency_t;
+
+BLE_CSCS_C_ARRAY_DEF(m_cscs_c, NRF_SDH_BLE_TOTAL_LINK_COUNT);
+
+static void app_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context);
+
+NRF_SDH_BLE_OBSERVER(m_app_obs, 3, app_on_ble_evt, NULL);
+
+static peer_t    m_peers[PEER_COUNT_MAX];
+static latency_t m_latency[PEER_COUNT_MAX];
+static uint64_t  m_send_ns;         /**< Time the event being passed to the observers was sent. */
+static uint32_t  m_meas_count;
+static uint32_t  m_disc_count;
+
+static uint32_t random_get(uint32_t min, uint32_t max)
+{
+    return min + (uint32_t)rand() % (max - min + 1);
+}
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    switch (p_evt->evt_type)
+    {
+        case BLE_CSCS_C_EVT_DISCOVERY_COMPLETE:
+            TEST_CHECK(ble_cscs_c_handles_assign(p_ble_cscs_c, p_evt->conn_handle, &p_evt->params.cscs_db) == NRF_SUCCESS);
+            TEST_CHECK(ble_cscs_c_csm_notif_enable(p_ble_cscs_c) == NRF_SUCCESS);
+            m_disc_count++;
+            break;
+
+        case BLE_CSCS_C_EVT_CSM_NOTIFICATION:
+        {
+            uint64_t   ns          = test_ns_get() - m_send_ns;
+            latency_t * p_latency  = &m_latency[p_evt->conn_handle];
+
+            if (p_latency->count < LATENCY_SAMPLES_MAX)
+            {
+                p_latency->ns[p_latency->count++] = (uint32_t)MIN(ns, UINT32_MAX);
+            }
+            m_meas_count++;
+        } break;
+
+        default:
+            break;
+    }
+}
+
+/**@brief   Application observer: counts the links, as the application would to start discovery. */
+static void app_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context)
+{
+    if (p_ble_evt->header.evt_id == BLE_GAP_EVT_CONNECTED)
+    {
+        TEST_CHECK(p_ble_evt->evt.gap_evt.conn_handle < PEER_COUNT_MAX);
+    }
+}
+
+static void evt_send(ble_evt_t const * p_ble_evt)
+{
+    m_send_ns = test_ns_get();
+    nrf_sdh_ble_evt_send(p_ble_evt);
+}
+
+/**@brief   Function for answering the requests queued by the instances, through the observers. */
+static void gq_serve(void)
+{
+    test_gq_req_t const * p_req;
+
+    while ((p_req = test_gq_take()) != NULL)
+    {
+        test_evt_t evt;
+
+        test_rsp_build(&evt, p_req, BLE_GATT_STATUS_SUCCESS, NULL, 0);
+        evt_send(&evt.evt);
+    }
+}
+
+/**@brief   Function for running the next event of a peer. */
+static void peer_step(uint16_t conn_handle)
+{
+    peer_t   * p_peer = &m_peers[conn_handle];
+    test_evt_t evt;
+
+    test_now_ms = p_peer->next_ms;
+
+    switch (p_peer->state)
+    {
+        case PEER_IDLE:
+            memset(&evt, 0, sizeof(evt));
+            evt.evt.header.evt_id          = BLE_GAP_EVT_CONNECTED;
+            evt.evt.evt.gap_evt.conn_handle = conn_handle;
+            evt_send(&evt.evt);
+
+            p_peer->state         = PEER_DISCOVERING;
+            p_peer->next_ms      += DISC_DURATION_MS;
+            p_peer->disconnect_ms = p_peer->next_ms + random_get(SESSION_MIN_MS, SESSION_MAX_MS);
+            break;
+
+        case PEER_DISCOVERING:
+        {
+            ble_db_discovery_evt_t disc_evt;
+
+            // The discovery module calls the application, which passes the event to the instance.
+            test_db_disc_evt_build(&disc_evt, conn_handle);
+            ble_cscs_on_db_disc_evt(&m_cscs_c[conn_handle], &disc_evt);
+            gq_serve();
+
+            p_peer->state    = PEER_NOTIFYING;
+            p_peer->next_ms += CONN_INTERVAL_MS;
+        } break;
+
+        case PEER_NOTIFYING:
+            if (p_peer->next_ms >= p_peer->disconnect_ms)
+            {
+                test_disconnected_build(&evt, conn_handle);
+                evt_send(&evt.evt);
+
+                p_peer->state    = PEER_IDLE;
+                p_peer->next_ms += random_get(RECONNECT_MIN_MS, RECONNECT_MAX_MS);
+            }
+            else
+            {
+                uint8_t data[11];
+
+                p_peer->wheel_revs += 2;
+                p_peer->wheel_time += 1024 * 2 * p_peer->interval_ms / 1000;
+                p_peer->crank_revs += 1;
+                p_peer->crank_time += 1024 * p_peer->interval_ms / 1000;
+
+                test_hvx_build(&evt, conn_handle, TEST_CSCM_HANDLE, data,
+                               test_meas_encode(data, p_peer->flags, p_peer->wheel_revs, p_peer->wheel_time,
+                                                p_peer->crank_revs, p_peer->crank_time));
+                evt_send(&evt.evt);
+
+                p_peer->next_ms += p_peer->interval_ms - p_peer->jitter_ms + random_get(0, 2 * p_peer->jitter_ms);
+            }
+            break;
+    }
+}
+
+static int latency_cmp(void const * p_a, void const * p_b)
+{
+    uint32_t a = *(uint32_t const *)p_a;
+    uint32_t b = *(uint32_t const *)p_b;
+
+    return (a > b) - (a < b);
+}
+
+static uint32_t percentile_get(latency_t * p_latency, uint32_t permille)
+{
+    TEST_CHECK(p_latency->count > 0);
+    qsort(p_latency->ns, p_latency->count, sizeof(p_latency->ns[0]), latency_cmp);
+
+    return p_latency->ns[(uint64_t)(p_latency->count - 1) * permille / 1000];
+}
+
+static uint64_t cpu_ns_get(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**@brief   Function for simulating @p peer_count peers and printing the results. */
+static void simulate(uint32_t peer_count)
+{
+    static uint16_t const intervals_ms[] = {250, 500, 1000};
+
+    ble_cscs_c_init_t init = {.evt_handler = evt_handler, .p_gatt_queue = &test_gatt_queue};
+    uint32_t          evt_count = 0;
+
+    srand(peer_count);
+    test_gq_reset();
+    memset(m_latency, 0, sizeof(m_latency));
+    m_meas_count = 0;
+    m_disc_count = 0;
+
+    for (uint32_t i = 0; i < NRF_SDH_BLE_TOTAL_LINK_COUNT; i++)
+    {
+        TEST_CHECK(ble_cscs_c_init(&m_cscs_c[i], &init) == NRF_SUCCESS);
+    }
+
+    for (uint32_t i = 0; i < peer_count; i++)
+    {
+        peer_t * p_peer = &m_peers[i];
+
+        memset(p_peer, 0, sizeof(*p_peer));
+        p_peer->flags       = (uint8_t)(1 + i % 3);
+        p_peer->interval_ms = intervals_ms[(i / 3) % ARRAY_SIZE(intervals_ms)];
+        p_peer->jitter_ms   = p_peer->interval_ms / 10;
+        p_peer->state       = PEER_IDLE;
+        p_peer->next_ms     = random_get(0, RECONNECT_MAX_MS);
+    }
+
+    uint64_t start_ns     = test_ns_get();
+    uint64_t start_cpu_ns = cpu_ns_get();
+
+    for (;;)
+    {
+        uint32_t next = 0;
+
+        for (uint32_t i = 1; i < peer_count; i++)
+        {
+            next = (m_peers[i].next_ms < m_peers[next].next_ms) ? i : next;
+        }
+        if (m_peers[next].next_ms >= SIM_DURATION_MS)
+        {
+            break;
+        }
+
+        peer_step((uint16_t)next);
+        evt_count++;
+    }
+
+    uint64_t elapsed_ns = test_ns_get() - start_ns;
+    uint64_t cpu_ns     = cpu_ns_get() - start_cpu_ns;
+    uint32_t p50[PEER_COUNT_MAX];
+    uint32_t p99_max = 0;
+
+    for (uint32_t i = 0; i < peer_count; i++)
+    {
+        p50[i]  = percentile_get(&m_latency[i], 500);
+        p99_max = MAX(p99_max, percentile_get(&m_latency[i], 990));
+    }
+    qsort(p50, peer_count, sizeof(p50[0]), latency_cmp);
+
+    TEST_CHECK(m_disc_count >= peer_count);
+
+    printf("%5u %8u %8u %12.0f %9u %9u %9.1f %12.1f\n", (unsigned)peer_count, (unsigned)evt_count,
+           (unsigned)m_meas_count, evt_count * 1e9 / (double)elapsed_ns, (unsigned)p50[peer_count / 2],
+           (unsigned)p99_max, (double)cpu_ns / 1e6, (double)cpu_ns / m_meas_count);
+}
+
+int main(void)
+{
+    printf("%u s simulated per run, %u instances in the observer array\n",
+           SIM_DURATION_MS / 1000, NRF_SDH_BLE_TOTAL_LINK_COUNT);
+    printf("%5s %8s %8s %12s %9s %9s %9s %12s\n",
+           "links", "events", "notifs", "events/s", "p50 ns", "p99 ns", "cpu ms", "cpu ns/notif");
+
+    for (uint32_t peer_count = 1; peer_count <= PEER_COUNT_MAX; peer_count++)
+    {
+        simulate(peer_count);
+    }
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+/* Connection events from the handle assignment to the first usable measurement, with the CCCD write
+ * and the CSC Feature and Sensor Location reads issued one at a time by the application, as before
+ * ble_cscs_c_setup, and queued at once by ble_cscs_c_setup.
+ *
+ * A measurement is usable once notifications are on and the feature and sensor location are known.
+ * The peer answers one request per connection event, as with an ATT bearer that allows a single
+ * outstanding request.
+ */
+#include "test_host.h"
+
+#define CONN_INTERVAL_MS    30      /**< Connection interval of the simulated link. */
+#define MEAS_INTERVAL_MS    1000    /**< Interval between two notifications of the sensor. */
+#define PHASE_COUNT         1000    /**< Sensor phases simulated. */
+#define EVENT_LIMIT         1000    /**< Connection events after which a run is a failure. */
+
+/**@brief   Ways the requests are issued. */
+typedef enum
+{
+    FLOW_SEQUENTIAL,    /**< ble_cscs_c_csm_notif_enable, then each read issued on the previous response. */
+    FLOW_SETUP,         /**< ble_cscs_c_setup. */
+    FLOW_COUNT
+} flow_t;
+
+/**@brief   Result of one simulated connection. */
+typedef struct
+{
+    uint32_t ready_event;       /**< Connection event in which the last request was answered. */
+    uint32_t usable_event;      /**< Connection event in which the first usable measurement arrived. */
+    uint32_t request_count;     /**< Requests issued. */
+} result_t;
+
+static ble_cscs_c_t m_cscs_c;
+static bool         m_is_ready;
+static uint32_t     m_usable_count;
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    switch (p_evt->evt_type)
+    {
+        case BLE_CSCS_C_EVT_READY:
+            TEST_CHECK(p_evt->params.ready.is_notif_enabled);
+            TEST_CHECK(p_evt->params.ready.is_feature_present && (p_evt->params.ready.feature == TEST_FEATURE_VALUE));
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+            TEST_CHECK(p_evt->params.ready.is_sensor_location_present);
+            TEST_CHECK(p_evt->params.ready.sensor_location == TEST_SENSLOC_VALUE);
+#endif
+            m_is_ready = true;
+            break;
+
+        case BLE_CSCS_C_EVT_CSM_NOTIFICATION:
+            m_usable_count += m_is_ready ? 1 : 0;
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**@brief   Function for queuing a read the way an application does without ble_cscs_c_setup. */
+static void app_read(uint16_t handle)
+{
+    nrf_ble_gq_req_t req;
+
+    memset(&req, 0, sizeof(req));
+    req.type                     = NRF_BLE_GQ_REQ_GATTC_READ;
+    req.params.gattc_read.handle = handle;
+
+    TEST_CHECK(nrf_ble_gq_item_add(&test_gatt_queue, &req, TEST_CONN_HANDLE) == NRF_SUCCESS);
+}
+
+/**@brief   Function for the sequential application: each response starts the next request, and
+ *          the last one makes the measurements usable.
+ */
+static void app_on_response(test_gq_req_t const * p_req)
+{
+    switch (p_req->handle)
+    {
+        case TEST_CSCM_CCCD_HANDLE:
+            app_read(TEST_FEATURE_HANDLE);
+            break;
+
+        case TEST_FEATURE_HANDLE:
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+            app_read(TEST_SENSLOC_HANDLE);
+            break;
+
+        case TEST_SENSLOC_HANDLE:
+#endif
+            m_is_ready = true;
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**@brief   Function for simulating a connection from the handle assignment.
+ *
+ * @details In each connection event the peer answers the oldest queued request, and the sensor
+ *          notifies every MEAS_INTERVAL_MS from @p phase_ms once its CCCD is set.
+ */
+static result_t connection_simulate(flow_t flow, uint32_t phase_ms)
+{
+    ble_cscs_c_init_t init         = {.evt_handler = evt_handler};
+    bool              is_cccd_set  = false;
+    uint32_t          next_meas_ms = phase_ms;
+    result_t          result       = {0, 0, 0};
+
+    test_gq_reset();
+    memset(&m_cscs_c, 0, sizeof(m_cscs_c));
+    test_client_start(&m_cscs_c, &init);
+    m_is_ready     = false;
+    m_usable_count = 0;
+
+    TEST_CHECK(((flow == FLOW_SETUP) ? ble_cscs_c_setup(&m_cscs_c)
+                                     : ble_cscs_c_csm_notif_enable(&m_cscs_c)) == NRF_SUCCESS);
+
+    for (uint32_t event = 1; event < EVENT_LIMIT; event++)
+    {
+        test_gq_req_t const * p_req = test_gq_serve(&m_cscs_c);
+
+        if (p_req != NULL)
+        {
+            if (p_req->handle == TEST_CSCM_CCCD_HANDLE)
+            {
+                is_cccd_set = (p_req->value[0] & BLE_GATT_HVX_NOTIFICATION) != 0;
+            }
+            if (flow == FLOW_SEQUENTIAL)
+            {
+                app_on_response(p_req);
+            }
+            if (m_is_ready && (result.ready_event == 0))
+            {
+                result.ready_event = event;
+            }
+        }
+
+        // The sensor notifies in the first connection event after its measurement.
+        while (next_meas_ms <= event * CONN_INTERVAL_MS)
+        {
+            if (is_cccd_set)
+            {
+                uint8_t data[11];
+
+                test_hvx_send(&m_cscs_c, data, test_meas_encode(data, 0x03, 1, 1, 1, 1));
+            }
+            next_meas_ms += MEAS_INTERVAL_MS;
+        }
+
+        if (m_usable_count > 0)
+        {
+            result.usable_event  = event;
+            result.request_count = test_gq.write_count + test_gq.read_count;
+
+            return result;
+        }
+    }
+
+    TEST_CHECK(false);
+
+    return result;
+}
+
+int main(void)
+{
+    static char const * const names[] = {"sequential", "ble_cscs_c_setup"};
+
+    printf("connection events from the handle assignment, %u ms connection interval, %u ms sensor interval:\n",
+           CONN_INTERVAL_MS, MEAS_INTERVAL_MS);
+    printf("  %-18s %8s %14s %14s %14s\n", "flow", "requests", "last response", "usable mean", "usable max");
+
+    for (flow_t flow = FLOW_SEQUENTIAL; flow < FLOW_COUNT; flow++)
+    {
+        uint64_t usable_sum = 0;
+        uint32_t usable_max = 0;
+        result_t result;
+
+        for (uint32_t i = 0; i < PHASE_COUNT; i++)
+        {
+            result      = connection_simulate(flow, (uint32_t)((uint64_t)i * MEAS_INTERVAL_MS / PHASE_COUNT));
+            usable_sum += result.usable_event;
+            usable_max  = MAX(usable_max, result.usable_event);
+        }
+
+        printf("  %-18s %8u %14u %14.1f %14u\n", names[flow], (unsigned)result.request_count,
+               (unsigned)result.ready_event, (double)usable_sum / PHASE_COUNT, (unsigned)usable_max);
+    }
+
+    return 0;
+}
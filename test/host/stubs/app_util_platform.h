@@ -0,0 +1,12 @@
+/* Host stand-in for app_util_platform.h.
+ *
+ * The host tests run the SoftDevice observer and the application on one thread whenever a
+ * critical region is taken, so it is empty.
+ */
+#ifndef APP_UTIL_PLATFORM_H__
+#define APP_UTIL_PLATFORM_H__
+
+#define CRITICAL_REGION_ENTER()
+#define CRITICAL_REGION_EXIT()
+
+#endif // APP_UTIL_PLATFORM_H__
@@ -0,0 +1,26 @@
+/* Host stand-in for the SoftDevice ble.h. */
+#ifndef BLE_H__
+#define BLE_H__
+
+#include <stdint.h>
+#include "ble_types.h"
+#include "ble_gap.h"
+#include "ble_gattc.h"
+
+typedef struct
+{
+    uint16_t evt_id;
+    uint16_t evt_len;
+} ble_evt_hdr_t;
+
+typedef struct
+{
+    ble_evt_hdr_t header;
+    union
+    {
+        ble_gap_evt_t   gap_evt;
+        ble_gattc_evt_t gattc_evt;
+    } evt;
+} ble_evt_t;
+
+#endif // BLE_H__
@@ -0,0 +1,49 @@
+/* Host stand-in for ble_db_discovery.h. */
+#ifndef BLE_DB_DISCOVERY_H__
+#define BLE_DB_DISCOVERY_H__
+
+#include <stdint.h>
+#include "ble.h"
+
+#define BLE_GATT_DB_MAX_CHARS   6
+
+typedef struct
+{
+    ble_uuid_t uuid;
+    uint16_t   handle_value;
+} ble_gattc_char_t;
+
+typedef struct
+{
+    ble_gattc_char_t characteristic;
+    uint16_t         cccd_handle;
+} ble_gatt_db_char_t;
+
+typedef struct
+{
+    ble_uuid_t         srv_uuid;
+    uint8_t            char_count;
+    ble_gatt_db_char_t charateristics[BLE_GATT_DB_MAX_CHARS];
+} ble_gatt_db_srv_t;
+
+typedef enum
+{
+    BLE_DB_DISCOVERY_COMPLETE,
+    BLE_DB_DISCOVERY_ERROR,
+    BLE_DB_DISCOVERY_SRV_NOT_FOUND,
+    BLE_DB_DISCOVERY_AVAILABLE
+} ble_db_discovery_evt_type_t;
+
+typedef struct
+{
+    ble_db_discovery_evt_type_t evt_type;
+    uint16_t                    conn_handle;
+    union
+    {
+        ble_gatt_db_srv_t discovered_db;
+    } params;
+} ble_db_discovery_evt_t;
+
+uint32_t ble_db_discovery_evt_register(ble_uuid_t const * p_uuid);
+
+#endif // BLE_DB_DISCOVERY_H__
@@ -0,0 +1,48 @@
+/* Host stand-in for the SoftDevice ble_gap.h. */
+#ifndef BLE_GAP_H__
+#define BLE_GAP_H__
+
+#include <stdint.h>
+
+#define BLE_GAP_ADDR_LEN    6
+
+typedef struct
+{
+    uint8_t addr_id_peer : 1;
+    uint8_t addr_type    : 7;
+    uint8_t addr[BLE_GAP_ADDR_LEN];
+} ble_gap_addr_t;
+
+typedef struct
+{
+    uint16_t min_conn_interval;
+    uint16_t max_conn_interval;
+    uint16_t slave_latency;
+    uint16_t conn_sup_timeout;
+} ble_gap_conn_params_t;
+
+typedef struct
+{
+    ble_gap_addr_t        peer_addr;
+    uint8_t               role;
+    ble_gap_conn_params_t conn_params;
+} ble_gap_evt_connected_t;
+
+typedef struct
+{
+    uint8_t reason;
+} ble_gap_evt_disconnected_t;
+
+typedef struct
+{
+    uint16_t conn_handle;
+    union
+    {
+        ble_gap_evt_connected_t    connected;
+        ble_gap_evt_disconnected_t disconnected;
+    } params;
+} ble_gap_evt_t;
+
+uint32_t sd_ble_gap_conn_param_update(uint16_t conn_handle, ble_gap_conn_params_t const * p_conn_params);
+
+#endif // BLE_GAP_H__
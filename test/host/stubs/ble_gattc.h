@@ -0,0 +1,55 @@
+/* Host stand-in for the SoftDevice ble_gattc.h. */
+#ifndef BLE_GATTC_H__
+#define BLE_GATTC_H__
+
+#include <stdint.h>
+
+typedef struct
+{
+    uint16_t handle;
+    uint8_t  type;
+    uint16_t len;
+    uint8_t  data[1];
+} ble_gattc_evt_hvx_t;
+
+typedef struct
+{
+    uint16_t handle;
+    uint16_t offset;
+    uint16_t len;
+    uint8_t  data[1];
+} ble_gattc_evt_read_rsp_t;
+
+typedef struct
+{
+    uint16_t handle;
+    uint8_t  write_op;
+    uint16_t offset;
+    uint16_t len;
+    uint8_t  data[1];
+} ble_gattc_evt_write_rsp_t;
+
+typedef struct
+{
+    uint16_t conn_handle;
+    uint16_t gatt_status;
+    uint16_t error_handle;
+    union
+    {
+        ble_gattc_evt_hvx_t       hvx;
+        ble_gattc_evt_read_rsp_t  read_rsp;
+        ble_gattc_evt_write_rsp_t write_rsp;
+    } params;
+} ble_gattc_evt_t;
+
+typedef struct
+{
+    uint8_t         write_op;
+    uint8_t         flags;
+    uint16_t        handle;
+    uint16_t        offset;
+    uint16_t        len;
+    uint8_t const * p_value;
+} ble_gattc_write_params_t;
+
+#endif // BLE_GATTC_H__
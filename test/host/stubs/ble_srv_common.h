@@ -0,0 +1,9 @@
+/* Host stand-in for ble_srv_common.h. */
+#ifndef BLE_SRV_COMMON_H__
+#define BLE_SRV_COMMON_H__
+
+#include <stdint.h>
+
+typedef void (* ble_srv_error_handler_t)(uint32_t nrf_error);
+
+#endif // BLE_SRV_COMMON_H__
@@ -0,0 +1,38 @@
+/* Host stand-in for the SoftDevice ble_types.h. */
+#ifndef BLE_TYPES_H__
+#define BLE_TYPES_H__
+
+#include <stdint.h>
+
+#define BLE_CONN_HANDLE_INVALID                     0xFFFF
+#define BLE_GATT_HANDLE_INVALID                     0x0000
+
+#define BLE_UUID_TYPE_BLE                           0x01
+#define BLE_UUID_CYCLING_SPEED_AND_CADENCE          0x1816
+#define BLE_UUID_CSC_MEASUREMENT_CHAR               0x2A5B
+#define BLE_UUID_CSC_FEATURE_CHAR                   0x2A5C
+#define BLE_UUID_SENSOR_LOCATION_CHAR               0x2A5D
+
+#define BLE_CCCD_VALUE_LEN                          2
+
+#define BLE_GATT_HVX_NOTIFICATION                   0x01
+#define BLE_GATT_OP_WRITE_REQ                       0x01
+#define BLE_GATT_EXEC_WRITE_FLAG_PREPARED_WRITE     0x01
+
+#define BLE_GATT_STATUS_SUCCESS                     0x0000
+#define BLE_GATT_STATUS_ATTERR_INVALID_HANDLE       0x0101
+#define BLE_GATT_STATUS_ATTERR_ATTRIBUTE_NOT_FOUND  0x010A
+
+#define BLE_GAP_EVT_CONNECTED                       0x10
+#define BLE_GAP_EVT_DISCONNECTED                    0x11
+#define BLE_GATTC_EVT_READ_RSP                      0x35
+#define BLE_GATTC_EVT_WRITE_RSP                     0x37
+#define BLE_GATTC_EVT_HVX                           0x38
+
+typedef struct
+{
+    uint16_t uuid;
+    uint8_t  type;
+} ble_uuid_t;
+
+#endif // BLE_TYPES_H__
@@ -0,0 +1,42 @@
+/* Host stand-in for the Flash Data Storage API used by ble_cscs_c_db_cache_fds.c. */
+#ifndef FDS_H__
+#define FDS_H__
+
+#include <stdint.h>
+
+typedef struct
+{
+    uint32_t record_id;
+} fds_record_desc_t;
+
+typedef struct
+{
+    uint32_t page;
+    uint32_t p_addr;
+} fds_find_token_t;
+
+typedef struct
+{
+    void const * p_header;
+    void const * p_data;
+} fds_flash_record_t;
+
+typedef struct
+{
+    uint16_t file_id;
+    uint16_t key;
+    struct
+    {
+        void const * p_data;
+        uint32_t     length_words;
+    } data;
+} fds_record_t;
+
+uint32_t fds_record_find(uint16_t file_id, uint16_t record_key, fds_record_desc_t * p_desc, fds_find_token_t * p_token);
+uint32_t fds_record_open(fds_record_desc_t * p_desc, fds_flash_record_t * p_flash_record);
+uint32_t fds_record_close(fds_record_desc_t * p_desc);
+uint32_t fds_record_write(fds_record_desc_t * p_desc, fds_record_t const * p_record);
+uint32_t fds_record_update(fds_record_desc_t * p_desc, fds_record_t const * p_record);
+uint32_t fds_record_delete(fds_record_desc_t * p_desc);
+
+#endif // FDS_H__
@@ -0,0 +1,45 @@
+/* Host stand-in for nrf_ble_gq.h. The harness implements the queue in test_host.h. */
+#ifndef NRF_BLE_GQ_H__
+#define NRF_BLE_GQ_H__
+
+#include <stdint.h>
+#include "ble.h"
+
+typedef enum
+{
+    NRF_BLE_GQ_REQ_GATTC_READ,
+    NRF_BLE_GQ_REQ_GATTC_WRITE
+} nrf_ble_gq_req_type_t;
+
+typedef void (* nrf_ble_gq_req_error_cb_t)(uint32_t nrf_error, void * p_context, uint16_t conn_handle);
+
+typedef struct
+{
+    uint16_t handle;
+    uint16_t offset;
+} nrf_ble_gq_gattc_read_t;
+
+typedef struct
+{
+    nrf_ble_gq_req_type_t type;
+    struct
+    {
+        nrf_ble_gq_req_error_cb_t cb;
+        void                    * p_ctx;
+    } error_handler;
+    union
+    {
+        ble_gattc_write_params_t gattc_write;
+        nrf_ble_gq_gattc_read_t  gattc_read;
+    } params;
+} nrf_ble_gq_req_t;
+
+typedef struct
+{
+    int unused;
+} nrf_ble_gq_t;
+
+uint32_t nrf_ble_gq_item_add(nrf_ble_gq_t const * p_gatt_queue, nrf_ble_gq_req_t * p_req, uint16_t conn_handle);
+uint32_t nrf_ble_gq_conn_handle_register(nrf_ble_gq_t * p_gatt_queue, uint16_t conn_handle);
+
+#endif // NRF_BLE_GQ_H__
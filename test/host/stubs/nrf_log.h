@@ -0,0 +1,11 @@
+/* Host stand-in for nrf_log.h. Logging is compiled out. */
+#ifndef NRF_LOG_H__
+#define NRF_LOG_H__
+
+#define NRF_LOG_MODULE_REGISTER()   struct CONCAT_2(nrf_log_module_, __LINE__)
+#define NRF_LOG_ERROR(...)
+#define NRF_LOG_WARNING(...)
+#define NRF_LOG_INFO(...)
+#define NRF_LOG_DEBUG(...)
+
+#endif // NRF_LOG_H__
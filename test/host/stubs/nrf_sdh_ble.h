@@ -0,0 +1,41 @@
+/* Host stand-in for nrf_sdh_ble.h.
+ *
+ * Observers are placed in the sdh_ble_observers section like on target, and
+ * nrf_sdh_ble_evt_send() in test_host.h passes an event to each of them. Priorities are ignored.
+ */
+#ifndef NRF_SDH_BLE_H__
+#define NRF_SDH_BLE_H__
+
+#include "ble.h"
+#include "sdk_config.h"
+
+typedef void (* nrf_sdh_ble_evt_handler_t)(ble_evt_t const * p_ble_evt, void * p_context);
+
+typedef struct
+{
+    nrf_sdh_ble_evt_handler_t handler;
+    void                    * p_context;
+} nrf_sdh_ble_evt_observer_t;
+
+#define NRF_SDH_BLE_OBSERVER_SECTION  __attribute__((section("sdh_ble_observers"), used, aligned(sizeof(void *))))
+
+#define NRF_SDH_BLE_OBSERVER(_name, _prio, _handler, _context)                                     \
+static nrf_sdh_ble_evt_observer_t _name NRF_SDH_BLE_OBSERVER_SECTION =                             \
+{                                                                                                   \
+    .handler   = _handler,                                                                          \
+    .p_context = _context                                                                           \
+}
+
+// _context is the address of the array of instances; observer i gets the address of instance i.
+#define NRF_SDH_BLE_OBSERVERS(_name, _prio, _handler, _context, _cnt)                              \
+static nrf_sdh_ble_evt_observer_t _name[_cnt] NRF_SDH_BLE_OBSERVER_SECTION;                        \
+static void __attribute__((constructor)) CONCAT_2(_name, _register)(void)                          \
+{                                                                                                   \
+    for (uint32_t i = 0; i < (_cnt); i++)                                                           \
+    {                                                                                               \
+        _name[i].handler   = _handler;                                                              \
+        _name[i].p_context = &(*(_context))[i];                                                     \
+    }                                                                                               \
+}
+
+#endif // NRF_SDH_BLE_H__
@@ -0,0 +1,79 @@
+/* Host stand-in for the parts of sdk_common.h used by the CSC client. */
+#ifndef SDK_COMMON_H__
+#define SDK_COMMON_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "sdk_config.h"
+
+#define NRF_SUCCESS                 0
+#define NRF_ERROR_INTERNAL          3
+#define NRF_ERROR_NO_MEM            4
+#define NRF_ERROR_NOT_FOUND         5
+#define NRF_ERROR_NOT_SUPPORTED     6
+#define NRF_ERROR_INVALID_PARAM     7
+#define NRF_ERROR_INVALID_STATE     8
+#define NRF_ERROR_INVALID_LENGTH    9
+#define NRF_ERROR_INVALID_DATA      11
+#define NRF_ERROR_NULL              14
+#define NRF_ERROR_BUSY              17
+
+typedef uint32_t ret_code_t;
+
+#define CONCAT_2_(p1, p2)           p1 ## p2
+#define CONCAT_2(p1, p2)            CONCAT_2_(p1, p2)
+#define CONCAT_3_(p1, p2, p3)       p1 ## p2 ## p3
+#define CONCAT_3(p1, p2, p3)        CONCAT_3_(p1, p2, p3)
+
+#define NRF_MODULE_ENABLED(module)  ((defined(module ## _ENABLED) && (module ## _ENABLED)) ? 1 : 0)
+
+#define VERIFY_PARAM_NOT_NULL(p)    do { if ((p) == NULL) { return NRF_ERROR_NULL; } } while (0)
+#define VERIFY_SUCCESS(err_code)    do { uint32_t _err = (err_code); if (_err != NRF_SUCCESS) { return _err; } } while (0)
+
+#define MIN(a, b)                   ((a) < (b) ? (a) : (b))
+#define MAX(a, b)                   ((a) < (b) ? (b) : (a))
+#define IS_POWER_OF_TWO(a)          (((a) != 0) && ((((a) - 1) & (a)) == 0))
+#define ARRAY_SIZE(arr)             (sizeof(arr) / sizeof((arr)[0]))
+#define BYTES_TO_WORDS(n)           (((n) + 3) / 4)
+#define LSB_16(a)                   ((uint8_t)((a) & 0x00FF))
+#define MSB_16(a)                   ((uint8_t)(((a) & 0xFF00) >> 8))
+
+// C99 has no _Static_assert; a negative array size fails the build the same way.
+#define STATIC_ASSERT(cond, ...)    typedef char CONCAT_2(static_assert_, __LINE__)[(cond) ? 1 : -1]
+
+// Data memory barrier, the C11 atomic_thread_fence(memory_order_seq_cst) on the host.
+#define __DMB()                     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/**@brief   Cycle counter of the host, in ns. Defined in test_host.h. */
+uint32_t test_cycle_count_get(void);
+
+static inline uint16_t uint16_decode(uint8_t const * p_encoded)
+{
+    return (uint16_t)(p_encoded[0] | (p_encoded[1] << 8));
+}
+
+static inline uint32_t uint32_decode(uint8_t const * p_encoded)
+{
+    return  (uint32_t)p_encoded[0]        | ((uint32_t)p_encoded[1] << 8) |
+           ((uint32_t)p_encoded[2] << 16) | ((uint32_t)p_encoded[3] << 24);
+}
+
+static inline uint8_t uint16_encode(uint16_t value, uint8_t * p_encoded)
+{
+    p_encoded[0] = (uint8_t)value;
+    p_encoded[1] = (uint8_t)(value >> 8);
+    return sizeof(uint16_t);
+}
+
+static inline uint8_t uint32_encode(uint32_t value, uint8_t * p_encoded)
+{
+    p_encoded[0] = (uint8_t)value;
+    p_encoded[1] = (uint8_t)(value >> 8);
+    p_encoded[2] = (uint8_t)(value >> 16);
+    p_encoded[3] = (uint8_t)(value >> 24);
+    return sizeof(uint32_t);
+}
+
+#endif // SDK_COMMON_H__
@@ -0,0 +1,90 @@
+/* Host sdk_config.h. Every option of the CSC client is off unless the test defines it first. */
+#ifndef SDK_CONFIG_H__
+#define SDK_CONFIG_H__
+
+#define BLE_CSCS_C_ENABLED                  1
+#define BLE_CSCS_C_BLE_OBSERVER_PRIO        2
+
+#ifndef NRF_SDH_BLE_TOTAL_LINK_COUNT
+#define NRF_SDH_BLE_TOTAL_LINK_COUNT        4
+#endif
+#ifndef NRF_SDH_BLE_CENTRAL_LINK_COUNT
+#define NRF_SDH_BLE_CENTRAL_LINK_COUNT      NRF_SDH_BLE_TOTAL_LINK_COUNT
+#endif
+
+#ifndef BLE_CSCS_C_DEFERRED_ENABLED
+#define BLE_CSCS_C_DEFERRED_ENABLED         0
+#endif
+#ifndef BLE_CSCS_C_DEFERRED_QUEUE_SIZE
+#define BLE_CSCS_C_DEFERRED_QUEUE_SIZE      16
+#endif
+
+#ifndef BLE_CSCS_C_CALC_ENABLED
+#define BLE_CSCS_C_CALC_ENABLED             0
+#endif
+#ifndef BLE_CSCS_C_CALC_STOP_COUNT
+#define BLE_CSCS_C_CALC_STOP_COUNT          3
+#endif
+
+#ifndef BLE_CSCS_C_DB_CACHE_ENABLED
+#define BLE_CSCS_C_DB_CACHE_ENABLED         0
+#endif
+#ifndef BLE_CSCS_C_DB_CACHE_FDS_ENABLED
+#define BLE_CSCS_C_DB_CACHE_FDS_ENABLED     0
+#endif
+#ifndef BLE_CSCS_C_DB_CACHE_FDS_FILE_ID
+#define BLE_CSCS_C_DB_CACHE_FDS_FILE_ID     0x1816
+#endif
+#ifndef BLE_CSCS_C_DB_CACHE_FDS_RECORD_KEY
+#define BLE_CSCS_C_DB_CACHE_FDS_RECORD_KEY  1
+#endif
+
+#ifndef BLE_CSCS_C_COUNTERS_ENABLED
+#define BLE_CSCS_C_COUNTERS_ENABLED         0
+#endif
+#ifndef BLE_CSCS_C_CYCLE_COUNT_GET
+// The host has no DWT: handler times are read from CLOCK_MONOTONIC, in ns.
+#define BLE_CSCS_C_CYCLE_COUNT_GET()        test_cycle_count_get()
+#endif
+#ifndef BLE_CSCS_C_CAPTURE_ENABLED
+#define BLE_CSCS_C_CAPTURE_ENABLED          0
+#endif
+#ifndef BLE_CSCS_C_MEAS_VIEW_ENABLED
+#define BLE_CSCS_C_MEAS_VIEW_ENABLED        0
+#endif
+#ifndef BLE_CSCS_C_FILTER_ENABLED
+#define BLE_CSCS_C_FILTER_ENABLED           0
+#endif
+
+#ifndef BLE_CSCS_C_STATS_ENABLED
+#define BLE_CSCS_C_STATS_ENABLED            0
+#endif
+#ifndef BLE_CSCS_C_STATS_SHORT_WINDOW
+#define BLE_CSCS_C_STATS_SHORT_WINDOW       3
+#endif
+#ifndef BLE_CSCS_C_STATS_LONG_WINDOW
+#define BLE_CSCS_C_STATS_LONG_WINDOW        30
+#endif
+
+#ifndef BLE_CSCS_C_FUSION_ENABLED
+#define BLE_CSCS_C_FUSION_ENABLED           0
+#endif
+#ifndef BLE_CSCS_C_FUSION_MAX_DRIFT_PPM
+#define BLE_CSCS_C_FUSION_MAX_DRIFT_PPM     500
+#endif
+
+#ifndef BLE_CSCS_C_CONN_POLICY_ENABLED
+#define BLE_CSCS_C_CONN_POLICY_ENABLED      0
+#endif
+#ifndef BLE_CSCS_C_SUSPEND_ENABLED
+#define BLE_CSCS_C_SUSPEND_ENABLED          0
+#endif
+
+#ifndef BLE_CSCS_C_CONTINUITY_ENABLED
+#define BLE_CSCS_C_CONTINUITY_ENABLED       0
+#endif
+#ifndef BLE_CSCS_C_CONTINUITY_PEER_COUNT
+#define BLE_CSCS_C_CONTINUITY_PEER_COUNT    4
+#endif
+
+#endif // SDK_CONFIG_H__
@@ -0,0 +1,215 @@
+/* Speed, cadence and distance derivation at the counter and event time wraparounds, with
+ * repeated event times and around BLE_CSCS_C_CALC_STOP_COUNT.
+ */
+#define BLE_CSCS_C_CALC_ENABLED     1
+#define BLE_CSCS_C_CALC_STOP_COUNT  3
+
+#include "test_host.h"
+
+#define CIRCUMFERENCE   2100    /**< Wheel circumference used by the tests, in mm. */
+
+static ble_cscs_c_t      m_cscs_c;
+static ble_cscs_c_calc_t m_calc;
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    if (p_evt->evt_type == BLE_CSCS_C_EVT_CSM_NOTIFICATION)
+    {
+        m_calc = p_evt->params.csc.calc;
+    }
+}
+
+static void client_start(void)
+{
+    ble_cscs_c_init_t init = {.evt_handler = evt_handler, .wheel_circumference = CIRCUMFERENCE};
+
+    test_client_start(&m_cscs_c, &init);
+}
+
+static void wheel_send(uint32_t revs, uint16_t time)
+{
+    uint8_t data[11];
+
+    test_hvx_send(&m_cscs_c, data, test_meas_encode(data, 0x01, revs, time, 0, 0));
+    TEST_CHECK(m_calc.is_speed_valid);
+}
+
+static void crank_send(uint16_t revs, uint16_t time)
+{
+    uint8_t data[11];
+
+    test_hvx_send(&m_cscs_c, data, test_meas_encode(data, 0x02, 0, 0, revs, time));
+    TEST_CHECK(m_calc.is_cadence_valid);
+}
+
+/**@brief   The 32-bit revolution counter and the 16-bit event time wrap between two events. */
+static void test_wheel_wrap(void)
+{
+    client_start();
+
+    wheel_send(0xFFFFFFFE, 65000);
+    TEST_CHECK((m_calc.speed == 0) && (m_calc.distance == 0));
+
+    // The first event only moves the reference, but its revolution counts as distance.
+    wheel_send(0xFFFFFFFF, 65000 + 512);
+    TEST_CHECK(m_calc.speed == 0);
+
+    // 2 revolutions in 1 s, both counters wrapped.
+    wheel_send(0x00000001, (uint16_t)(65000 + 512 + 1024));
+    TEST_CHECK(m_calc.speed == 2 * CIRCUMFERENCE);
+    TEST_CHECK(m_calc.distance == 3 * CIRCUMFERENCE / 1000);
+}
+
+/**@brief   The 16-bit crank counter and event time wrap between two events. */
+static void test_crank_wrap(void)
+{
+    client_start();
+
+    crank_send(65534, 64000);
+    crank_send(65535, 65024);
+
+    // 1 revolution in 1 s is 60 rpm.
+    crank_send(0, (uint16_t)(65024 + 1024));
+    TEST_CHECK(m_calc.cadence == 600);
+
+    // 2 revolutions in 0.5 s is 240 rpm.
+    crank_send(2, (uint16_t)(65024 + 1536));
+    TEST_CHECK(m_calc.cadence == 2400);
+}
+
+/**@brief   The event time wraps while the counter moves by a single revolution. */
+static void test_event_time_wrap(void)
+{
+    client_start();
+
+    wheel_send(100, 65535);
+    wheel_send(101, 0);
+    wheel_send(102, 1023);
+    TEST_CHECK(m_calc.speed == CIRCUMFERENCE * 1024 / 1023);
+}
+
+/**@brief   Sensors repeat the last event while no new one happened; the speed then drops to 0
+ *          after BLE_CSCS_C_CALC_STOP_COUNT measurements.
+ */
+static void test_stop_count(void)
+{
+    client_start();
+
+    wheel_send(10, 1000);
+    wheel_send(11, 2024);
+    wheel_send(12, 3048);
+    TEST_CHECK(m_calc.speed == CIRCUMFERENCE);
+
+    for (uint32_t i = 1; i < BLE_CSCS_C_CALC_STOP_COUNT; i++)
+    {
+        wheel_send(12, 3048);
+        TEST_CHECK(m_calc.speed == CIRCUMFERENCE);
+    }
+
+    wheel_send(12, 3048);
+    TEST_CHECK(m_calc.speed == 0);
+
+    // Still stopped: the event time may have wrapped any number of times, so the first event
+    // after the stop only moves the reference.
+    wheel_send(13, 100);
+    TEST_CHECK(m_calc.speed == 0);
+    wheel_send(14, 612);
+    TEST_CHECK(m_calc.speed == 2 * CIRCUMFERENCE);
+    TEST_CHECK(m_calc.distance == 4 * CIRCUMFERENCE / 1000);
+
+    // Same for the crank.
+    crank_send(1, 0);
+    crank_send(2, 1024);
+    crank_send(3, 2048);
+    TEST_CHECK(m_calc.cadence == 600);
+
+    for (uint32_t i = 0; i < BLE_CSCS_C_CALC_STOP_COUNT; i++)
+    {
+        crank_send(3, 2048);
+    }
+    TEST_CHECK(m_calc.cadence == 0);
+
+    crank_send(4, 9000);
+    TEST_CHECK(m_calc.cadence == 0);
+    crank_send(5, 10024);
+    TEST_CHECK(m_calc.cadence == 600);
+}
+
+/**@brief   A new revolution reported with an unchanged event time keeps the last speed instead of
+ *          dividing by zero, and still counts as distance.
+ */
+static void test_repeated_event_time(void)
+{
+    client_start();
+
+    wheel_send(0, 0);
+    wheel_send(1, 1024);
+    wheel_send(2, 2048);
+    TEST_CHECK(m_calc.speed == CIRCUMFERENCE);
+
+    wheel_send(3, 2048);
+    TEST_CHECK(m_calc.speed == CIRCUMFERENCE);
+    TEST_CHECK(m_calc.distance == 3 * CIRCUMFERENCE / 1000);
+
+    crank_send(0, 0);
+    crank_send(1, 1024);
+    crank_send(2, 2048);
+    crank_send(3, 2048);
+    TEST_CHECK(m_calc.cadence == 600);
+}
+
+/**@brief   A jump of more revolutions than possible between two events starts over from the new
+ *          counter without adding distance.
+ */
+static void test_counter_reset(void)
+{
+    client_start();
+
+    wheel_send(5000, 0);
+    wheel_send(5001, 1024);
+    wheel_send(5002, 2048);
+    uint32_t distance = m_calc.distance;
+
+    wheel_send(3, 3072);
+    TEST_CHECK((m_calc.speed == 0) && (m_calc.distance == distance));
+    wheel_send(4, 4096);
+    wheel_send(5, 5120);
+    TEST_CHECK(m_calc.speed == CIRCUMFERENCE);
+
+    crank_send(40000, 0);
+    crank_send(40001, 1024);
+    crank_send(40002, 2048);
+    crank_send(7, 3072);
+    TEST_CHECK(m_calc.cadence == 0);
+}
+
+/**@brief   Distance keeps the millimetres left over from each event. */
+static void test_distance_remainder(void)
+{
+    uint32_t revs = 0;
+
+    client_start();
+
+    wheel_send(revs, 0);
+    for (uint32_t i = 1; i <= 1000; i++)
+    {
+        revs += 1 + (i % 7);
+        wheel_send(revs, (uint16_t)(i * 1024));
+    }
+    TEST_CHECK(m_calc.distance == (uint64_t)revs * CIRCUMFERENCE / 1000);
+}
+
+int main(void)
+{
+    test_wheel_wrap();
+    test_crank_wrap();
+    test_event_time_wrap();
+    test_stop_count();
+    test_repeated_event_time();
+    test_counter_reset();
+    test_distance_remainder();
+
+    printf("calc: ok\n");
+
+    return 0;
+}
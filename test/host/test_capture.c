@@ -0,0 +1,173 @@
+/* Capture of raw notifications: the stream read back with ble_cscs_c_capture_read holds every
+ * notification whole and in order, and records that do not fit are dropped whole.
+ *
+ * With a file name argument, the captured ride is also written to that file. corpus/ride.cap was
+ * made this way, for the capture_replay regression in the Makefile.
+ */
+#define BLE_CSCS_C_CAPTURE_ENABLED  1
+
+#include "test_host.h"
+
+#define RIDE_LEN        600     /**< Notifications in the captured ride. */
+#define DRAIN_INTERVAL  10      /**< Notifications between two reads of the capture buffer. */
+#define STREAM_SIZE     (RIDE_LEN * (BLE_CSCS_C_CAPTURE_HEADER_LEN + 11))
+
+BLE_CSCS_C_CAPTURE_DEF(m_capture, 512);
+
+/**@brief   Notification as sent by the simulated sensor. */
+typedef struct
+{
+    uint32_t timestamp;
+    uint16_t handle;
+    uint16_t len;
+    uint8_t  data[11];
+} sent_t;
+
+static ble_cscs_c_t m_cscs_c;
+static sent_t       m_sent[RIDE_LEN];
+static uint8_t      m_stream[STREAM_SIZE];
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+}
+
+/**@brief   Function for generating a ride of 1 s notifications with jitter, a speed and cadence
+ *          that change, a stop, truncated payloads and notifications on another handle.
+ */
+static void ride_generate(void)
+{
+    uint32_t wheel_revs = 0xFFFFFF00;
+    uint16_t wheel_time = 65000;
+    uint16_t crank_revs = 65500;
+    uint16_t crank_time = 64000;
+
+    srand(1816);
+
+    for (uint32_t i = 0; i < RIDE_LEN; i++)
+    {
+        sent_t * p_sent  = &m_sent[i];
+        bool     stopped = (i >= 300) && (i < 330);
+
+        if (!stopped)
+        {
+            uint16_t wheel_period = (uint16_t)(400 + 200 * ((i / 100) % 3));   // 5.3, 3.5 and 2.6 m/s
+            uint16_t crank_period = (uint16_t)(700 + 100 * ((i / 150) % 2));   // 88 and 77 rpm
+
+            wheel_revs += 1024 / wheel_period;
+            wheel_time += (uint16_t)((1024 / wheel_period) * wheel_period);
+            crank_revs += 1;
+            crank_time += crank_period;
+        }
+
+        p_sent->timestamp = 1000 * i + (uint32_t)(rand() % 40);
+        p_sent->handle    = TEST_CSCM_HANDLE;
+        p_sent->len       = test_meas_encode(p_sent->data, (i % 200 < 150) ? 0x03 : 0x01,
+                                             wheel_revs, wheel_time, crank_revs, crank_time);
+
+        if ((i % 50) == 49)
+        {
+            p_sent->len = (uint16_t)(rand() % p_sent->len);
+        }
+        if ((i % 97) == 96)
+        {
+            p_sent->handle = TEST_FEATURE_HANDLE;
+        }
+    }
+}
+
+static void notif_send(sent_t const * p_sent)
+{
+    test_evt_t evt;
+
+    test_now_ms = p_sent->timestamp;
+    test_hvx_build(&evt, TEST_CONN_HANDLE, p_sent->handle, p_sent->data, p_sent->len);
+    ble_cscs_c_on_ble_evt(&evt.evt, &m_cscs_c);
+}
+
+static uint32_t capture_drain(uint8_t * p_dest, uint32_t size)
+{
+    uint32_t len = size;
+
+    TEST_CHECK(ble_cscs_c_capture_read(&m_capture, p_dest, &len) == NRF_SUCCESS);
+
+    return len;
+}
+
+/**@brief   Function for checking that a stream holds the given notifications, in order.
+ *
+ * @return  Number of records in the stream.
+ */
+static uint32_t stream_check(uint8_t const * p_stream, uint32_t len, sent_t const * p_sent, uint32_t sent_count)
+{
+    uint32_t offset = 0;
+    uint32_t count  = 0;
+
+    while (offset < len)
+    {
+        uint8_t const * p_rec = &p_stream[offset];
+
+        TEST_CHECK(offset + BLE_CSCS_C_CAPTURE_HEADER_LEN + p_rec[0] <= len);
+        TEST_CHECK(count < sent_count);
+        TEST_CHECK(p_rec[0] == p_sent[count].len);
+        TEST_CHECK(uint32_decode(&p_rec[1]) == p_sent[count].timestamp);
+        TEST_CHECK(uint16_decode(&p_rec[5]) == TEST_CONN_HANDLE);
+        TEST_CHECK(uint16_decode(&p_rec[7]) == p_sent[count].handle);
+        TEST_CHECK(memcmp(&p_rec[BLE_CSCS_C_CAPTURE_HEADER_LEN], p_sent[count].data, p_rec[0]) == 0);
+
+        offset += BLE_CSCS_C_CAPTURE_HEADER_LEN + p_rec[0];
+        count++;
+    }
+
+    return count;
+}
+
+int main(int argc, char ** argv)
+{
+    ble_cscs_c_init_t init = {.evt_handler = evt_handler, .timestamp_get = test_timestamp_get, .p_capture = &m_capture};
+    uint32_t          stream_len = 0;
+
+    ride_generate();
+    test_client_start(&m_cscs_c, &init);
+
+    // Read while capturing: every notification is in the stream, malformed ones included.
+    for (uint32_t i = 0; i < RIDE_LEN; i++)
+    {
+        notif_send(&m_sent[i]);
+
+        if ((i % DRAIN_INTERVAL) == DRAIN_INTERVAL - 1)
+        {
+            stream_len += capture_drain(&m_stream[stream_len], 37);
+            stream_len += capture_drain(&m_stream[stream_len], STREAM_SIZE - stream_len);
+        }
+    }
+    stream_len += capture_drain(&m_stream[stream_len], STREAM_SIZE - stream_len);
+
+    TEST_CHECK(m_capture.dropped_count == 0);
+    TEST_CHECK(stream_check(m_stream, stream_len, m_sent, RIDE_LEN) == RIDE_LEN);
+
+    if (argc > 1)
+    {
+        FILE * p_file = fopen(argv[1], "wb");
+
+        TEST_CHECK(p_file != NULL);
+        TEST_CHECK(fwrite(m_stream, stream_len, 1, p_file) == 1);
+        TEST_CHECK(fclose(p_file) == 0);
+    }
+
+    // Without reads the buffer fills up: the records that fit are kept whole and the rest are counted.
+    uint32_t fitting = 512 / (BLE_CSCS_C_CAPTURE_HEADER_LEN + 11);
+
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        notif_send(&m_sent[i]);
+    }
+    stream_len = capture_drain(m_stream, STREAM_SIZE);
+
+    uint32_t count = stream_check(m_stream, stream_len, m_sent, 100);
+
+    TEST_CHECK((count >= fitting) && (count + m_capture.dropped_count == 100));
+
+    printf("capture: %u records, %u of 100 kept in a full buffer, ok\n", RIDE_LEN, (unsigned)count);
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+/* Connection policy: a connection parameter request that the GAP backend rejects leaves the
+ * activity state as it was, and is repeated while the new state still applies.
+ */
+#define BLE_CSCS_C_CONN_POLICY_ENABLED  1
+
+#include "test_host.h"
+
+// Both modules register a log module of their own.
+#undef NRF_LOG_MODULE_NAME
+#include "ble_cscs_c_conn_policy.c"
+
+#define IDLE_TIMEOUT_MS     3000
+#define ACTIVE_COUNT        2
+#define ACTIVE_INTERVAL     24
+#define IDLE_INTERVAL       800
+
+static ble_cscs_c_conn_policy_t m_policy;
+static uint32_t                 m_err_code;         /**< Error returned by the backend. */
+static uint32_t                 m_call_count;
+static uint16_t                 m_interval;         /**< Interval of the last request. */
+static uint32_t                 m_wheel_revs;
+
+static uint32_t conn_param_update(uint16_t conn_handle, ble_gap_conn_params_t const * p_conn_params)
+{
+    TEST_CHECK(conn_handle == TEST_CONN_HANDLE);
+
+    m_interval = p_conn_params->max_conn_interval;
+    m_call_count++;
+
+    return m_err_code;
+}
+
+/**@brief   Function for passing a measurement at @p time_ms, with a new revolution if @p is_moving. */
+static void meas_send(uint32_t time_ms, bool is_moving)
+{
+    ble_cscs_c_meas_t meas;
+
+    memset(&meas, 0, sizeof(meas));
+    m_wheel_revs                   += is_moving ? 1 : 0;
+    meas.is_wheel_rev_data_present  = true;
+    meas.cumulative_wheel_revs      = m_wheel_revs;
+
+    ble_cscs_c_conn_policy_on_meas(&m_policy, TEST_CONN_HANDLE, time_ms, &meas);
+}
+
+/**@brief   Function for calling the policy at @p time_ms and checking the request it made, if any. */
+static void process_check(uint32_t                       time_ms,
+                          uint32_t                       err_code,
+                          uint32_t                       call_count,
+                          ble_cscs_c_conn_policy_state_t state,
+                          uint32_t                       update_count)
+{
+    m_err_code = err_code;
+    ble_cscs_c_conn_policy_process(&m_policy, TEST_CONN_HANDLE, time_ms);
+
+    TEST_CHECK(m_call_count == call_count);
+    TEST_CHECK(m_policy.state == state);
+    TEST_CHECK(m_policy.update_count == update_count);
+}
+
+int main(void)
+{
+    ble_cscs_c_conn_policy_config_t config = {.active_params     = {ACTIVE_INTERVAL, ACTIVE_INTERVAL, 0, 400},
+                                              .idle_params       = {IDLE_INTERVAL, IDLE_INTERVAL, 0, 600},
+                                              .idle_timeout      = IDLE_TIMEOUT_MS,
+                                              .active_count      = ACTIVE_COUNT,
+                                              .conn_param_update = conn_param_update};
+
+    TEST_CHECK(ble_cscs_c_conn_policy_init(&m_policy, &config) == NRF_SUCCESS);
+    meas_send(0, true);
+    meas_send(1000, true);
+    TEST_CHECK((m_call_count == 0) && (m_policy.state == BLE_CSCS_C_CONN_POLICY_ACTIVE));
+
+    // Idle: rejected, busy, then accepted.
+    process_check(10000, NRF_ERROR_INVALID_STATE, 1, BLE_CSCS_C_CONN_POLICY_ACTIVE, 0);
+    process_check(11000, NRF_ERROR_INVALID_STATE, 2, BLE_CSCS_C_CONN_POLICY_ACTIVE, 0);
+    process_check(12000, NRF_ERROR_BUSY, 3, BLE_CSCS_C_CONN_POLICY_ACTIVE, 0);
+    process_check(13000, NRF_SUCCESS, 4, BLE_CSCS_C_CONN_POLICY_IDLE, 1);
+    TEST_CHECK(m_interval == IDLE_INTERVAL);
+    process_check(14000, NRF_SUCCESS, 4, BLE_CSCS_C_CONN_POLICY_IDLE, 1);
+
+    // Moving again, counting from the stop: rejected with the measurement, repeated by the next call.
+    m_err_code = NRF_ERROR_INVALID_STATE;
+    meas_send(15000, true);
+    TEST_CHECK(m_call_count == 4);
+    meas_send(16000, true);
+    TEST_CHECK((m_call_count == 5) && (m_interval == ACTIVE_INTERVAL));
+    TEST_CHECK((m_policy.state == BLE_CSCS_C_CONN_POLICY_IDLE) && (m_policy.update_count == 1));
+    process_check(16500, NRF_ERROR_INVALID_STATE, 6, BLE_CSCS_C_CONN_POLICY_IDLE, 1);
+    process_check(16800, NRF_SUCCESS, 7, BLE_CSCS_C_CONN_POLICY_ACTIVE, 2);
+    TEST_CHECK(m_interval == ACTIVE_INTERVAL);
+
+    // Moving again, rejected, and stopped before the next call: the request is dropped.
+    process_check(30000, NRF_SUCCESS, 8, BLE_CSCS_C_CONN_POLICY_IDLE, 3);
+    m_err_code = NRF_ERROR_BUSY;
+    meas_send(31000, true);
+    meas_send(32000, true);
+    TEST_CHECK((m_call_count == 9) && (m_policy.state == BLE_CSCS_C_CONN_POLICY_IDLE));
+    meas_send(33000, false);
+    process_check(33500, NRF_SUCCESS, 9, BLE_CSCS_C_CONN_POLICY_IDLE, 3);
+
+    printf("conn policy: ok\n");
+
+    return 0;
+}
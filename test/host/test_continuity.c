@@ -0,0 +1,254 @@
+/* Counter continuity: a trace of links to several peers replayed through one instance, checking
+ * the continuity event and the distance after each measurement.
+ *
+ * The trace covers link drops, a sensor reset, an implausible jump, counters crossing 2^32 and
+ * 2^16, a link without a measurement, the eviction of the peer lost the longest time ago from a
+ * full table, and an erased peer.
+ */
+#define BLE_CSCS_C_CALC_ENABLED             1
+#define BLE_CSCS_C_DB_CACHE_ENABLED         1
+#define BLE_CSCS_C_CONTINUITY_ENABLED       1
+#define BLE_CSCS_C_CONTINUITY_PEER_COUNT    4
+
+#include "test_host.h"
+#include "ble_cscs_c_continuity.c"
+
+#define CIRCUMFERENCE   2000    /**< Wheel circumference used by the trace, in mm: 2 m per revolution. */
+#define NO_EVT          (-1)    /**< No continuity event expected before the measurement. */
+
+#define PEER_A          0
+#define PEER_B          1
+#define PEER_C          2
+#define PEER_D          3
+#define PEER_E          4
+
+/**@brief   Operations of the trace. */
+typedef enum
+{
+    OP_CONNECT,         /**< Link to @p peer, handles assigned as after discovery. */
+    OP_MEAS,            /**< Measurement with wheel and crank data. */
+    OP_DISCONNECT,      /**< Link lost. */
+    OP_ERASE            /**< @p peer erased from the table by the application. */
+} op_t;
+
+/**@brief   Step of the trace. */
+typedef struct
+{
+    uint32_t time_ms;
+    op_t     op;
+    uint8_t  peer;
+    uint32_t wheel_revs;        /**< Cumulative Wheel Revolutions of the measurement. */
+    uint16_t crank_revs;        /**< Cumulative Crank Revolutions of the measurement. */
+    uint32_t distance;          /**< Distance expected after the measurement, in m. */
+    int      wheel_result;      /**< Expected outcome for the wheel, or NO_EVT. */
+    uint32_t wheel_credit;      /**< Expected wheel revolutions credited over the gap. */
+    int      crank_result;      /**< Expected outcome for the crank. */
+    uint16_t crank_credit;      /**< Expected crank revolutions over the gap. */
+    uint32_t gap_ms;            /**< Expected time since the last link with a measurement. */
+} step_t;
+
+#define CONNECT(_t, _peer)      {.time_ms = (_t), .op = OP_CONNECT, .peer = (_peer)}
+#define DISCONNECT(_t)          {.time_ms = (_t), .op = OP_DISCONNECT}
+#define ERASE(_t, _peer)        {.time_ms = (_t), .op = OP_ERASE, .peer = (_peer)}
+#define MEAS(_t, _wheel, _crank, _dist)                                                       \
+    {.time_ms = (_t), .op = OP_MEAS, .wheel_revs = (_wheel), .crank_revs = (_crank),          \
+     .distance = (_dist), .wheel_result = NO_EVT, .crank_result = NO_EVT}
+#define FIRST(_t, _wheel, _crank, _dist, _gap, _wres, _wcredit, _cres, _ccredit)              \
+    {.time_ms = (_t), .op = OP_MEAS, .wheel_revs = (_wheel), .crank_revs = (_crank),          \
+     .distance = (_dist), .wheel_result = BLE_CSCS_C_CONTINUITY_##_wres,                      \
+     .wheel_credit = (_wcredit), .crank_result = BLE_CSCS_C_CONTINUITY_##_cres,               \
+     .crank_credit = (_ccredit), .gap_ms = (_gap)}
+
+static step_t const m_trace[] =
+{
+    // Link drop: the revolutions over the gap are credited.
+    CONNECT(0, PEER_A),
+    MEAS(1000, 1000, 100, 0),
+    MEAS(2000, 1002, 101, 4),
+    DISCONNECT(2500),
+    CONNECT(10000, PEER_A),
+    FIRST(12500, 1040, 120, 80, 10000, RESUMED, 38, RESUMED, 19),
+    MEAS(13500, 1045, 122, 90),
+    DISCONNECT(14000),
+
+    // Sensor reset: the revolutions counted since the reset are credited.
+    CONNECT(20000, PEER_A),
+    FIRST(24000, 5, 2, 100, 10000, RESET, 5, RESET, 2),
+    MEAS(25000, 8, 4, 106),
+    DISCONNECT(26000),
+
+    // Implausible jump for a 2 s gap: treated as a reset, nothing is credited.
+    CONNECT(27000, PEER_A),
+    FIRST(28000, 5008, 1004, 106, 2000, RESET, 0, RESET, 0),
+    MEAS(29000, 5010, 1005, 110),
+    DISCONNECT(30000),
+
+    // Counters crossing 2^32 and 2^16, over the gap and within a link.
+    CONNECT(40000, PEER_B),
+    MEAS(41000, 0xFFFFFF00, 0xFFF0, 0),
+    MEAS(42000, 0xFFFFFFF0, 0xFFF8, 480),
+    DISCONNECT(43000),
+    CONNECT(45000, PEER_B),
+    FIRST(48000, 0x40, 0x0008, 640, 5000, RESUMED, 0x50, RESUMED, 0x10),
+    MEAS(49000, 0x50, 0x000A, 672),
+    DISCONNECT(50000),
+
+    // A link without a measurement leaves the stored state and its time as they were.
+    CONNECT(51000, PEER_B),
+    DISCONNECT(52000),
+    CONNECT(53000, PEER_B),
+    FIRST(56000, 0x60, 0x000C, 704, 6000, RESUMED, 0x10, RESUMED, 2),
+    DISCONNECT(57000),
+
+    // Eviction from the full table of the peer lost longest ago: E replaces A, A replaces B, and
+    // B replaces D.
+    CONNECT(60000, PEER_C),
+    MEAS(61000, 10, 10, 0),
+    DISCONNECT(62000),
+    CONNECT(63000, PEER_D),
+    MEAS(64000, 20, 20, 0),
+    DISCONNECT(65000),
+    CONNECT(66000, PEER_E),
+    MEAS(67000, 30, 30, 0),
+    DISCONNECT(68000),
+    CONNECT(70000, PEER_A),
+    MEAS(71000, 5020, 1010, 0),
+    DISCONNECT(72000),
+    CONNECT(73000, PEER_C),
+    FIRST(74000, 12, 11, 4, 12000, RESUMED, 2, RESUMED, 1),
+    DISCONNECT(75000),
+    CONNECT(76000, PEER_B),
+    MEAS(77000, 0x70, 0x000E, 0),
+    DISCONNECT(78000),
+
+    // An erased peer starts over.
+    ERASE(79000, PEER_C),
+    CONNECT(80000, PEER_C),
+    MEAS(81000, 14, 12, 0),
+    DISCONNECT(82000),
+
+    // D, evicted by B, starts over too, although it has the address bytes of C.
+    CONNECT(83000, PEER_D),
+    MEAS(84000, 25, 22, 0),
+    DISCONNECT(85000),
+};
+
+static ble_gap_addr_t const m_peer_addrs[] =
+{
+    {.addr_type = 1, .addr = {0x01, 0x00, 0x00, 0x00, 0x00, 0xC0}},
+    {.addr_type = 1, .addr = {0x02, 0x00, 0x00, 0x00, 0x00, 0xC0}},
+    {.addr_type = 1, .addr = {0x03, 0x00, 0x00, 0x00, 0x00, 0xC0}},
+    {.addr_type = 0, .addr = {0x03, 0x00, 0x00, 0x00, 0x00, 0xC0}},     // Same bytes as C, public.
+    {.addr_type = 1, .addr = {0x05, 0x00, 0x00, 0x00, 0x00, 0xC0}},
+};
+
+static ble_cscs_c_t                 m_cscs_c;
+static ble_cscs_c_continuity_t      m_continuity;
+static ble_cscs_c_meas_t            m_last;
+static ble_cscs_c_continuity_info_t m_info;
+static uint32_t                     m_meas_count;
+static uint32_t                     m_continuity_count;
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    switch (p_evt->evt_type)
+    {
+        case BLE_CSCS_C_EVT_CSM_NOTIFICATION:
+            m_last = p_evt->params.csc;
+            m_meas_count++;
+            break;
+
+        case BLE_CSCS_C_EVT_CONTINUITY:
+            // Sent before the first measurement of the link.
+            TEST_CHECK(m_meas_count == 0);
+            m_info = p_evt->params.continuity;
+            m_continuity_count++;
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**@brief   Function for starting a link as the application does: restore, then discovery. */
+static void link_start(uint8_t peer)
+{
+    ble_cscs_c_db_t db;
+
+    TEST_CHECK(ble_cscs_c_handles_restore(&m_cscs_c, TEST_CONN_HANDLE, &m_peer_addrs[peer]) == NRF_ERROR_NOT_FOUND);
+    test_db_get(&db);
+    TEST_CHECK(ble_cscs_c_handles_assign(&m_cscs_c, TEST_CONN_HANDLE, &db) == NRF_SUCCESS);
+    m_meas_count = 0;
+}
+
+static void meas_check(step_t const * p_step)
+{
+    uint32_t continuity_count = m_continuity_count;
+    uint8_t  data[11];
+
+    test_hvx_send(&m_cscs_c, data, test_meas_encode(data, 0x03,
+                                                    p_step->wheel_revs, (uint16_t)(p_step->wheel_revs * 512),
+                                                    p_step->crank_revs, (uint16_t)(p_step->crank_revs * 1024)));
+
+    if (p_step->wheel_result == NO_EVT)
+    {
+        TEST_CHECK(m_continuity_count == continuity_count);
+    }
+    else
+    {
+        TEST_CHECK(m_continuity_count == continuity_count + 1);
+        TEST_CHECK(m_info.gap_ms == p_step->gap_ms);
+        TEST_CHECK((int)m_info.wheel_result == p_step->wheel_result);
+        TEST_CHECK(m_info.wheel_revs == p_step->wheel_credit);
+        TEST_CHECK((int)m_info.crank_result == p_step->crank_result);
+        TEST_CHECK(m_info.crank_revs == p_step->crank_credit);
+    }
+
+    TEST_CHECK(m_last.calc.is_speed_valid && (m_last.calc.distance == p_step->distance));
+}
+
+int main(void)
+{
+    ble_cscs_c_init_t init = {.evt_handler         = evt_handler,
+                              .p_gatt_queue        = &test_gatt_queue,
+                              .timestamp_get       = test_timestamp_get,
+                              .wheel_circumference = CIRCUMFERENCE,
+                              .p_continuity        = &m_continuity};
+
+    TEST_CHECK(ble_cscs_c_continuity_init(&m_continuity) == NRF_SUCCESS);
+    TEST_CHECK(ble_cscs_c_init(&m_cscs_c, &init) == NRF_SUCCESS);
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_trace); i++)
+    {
+        step_t const * p_step = &m_trace[i];
+
+        test_now_ms = p_step->time_ms;
+
+        switch (p_step->op)
+        {
+            case OP_CONNECT:
+                link_start(p_step->peer);
+                break;
+
+            case OP_MEAS:
+                meas_check(p_step);
+                break;
+
+            case OP_DISCONNECT:
+                test_disconnected_send(&m_cscs_c);
+                break;
+
+            case OP_ERASE:
+                TEST_CHECK(ble_cscs_c_continuity_erase(&m_continuity, &m_peer_addrs[p_step->peer]) == NRF_SUCCESS);
+                TEST_CHECK(ble_cscs_c_continuity_erase(&m_continuity, &m_peer_addrs[p_step->peer]) == NRF_ERROR_NOT_FOUND);
+                break;
+        }
+    }
+
+    TEST_CHECK(ble_cscs_c_continuity_init(NULL) == NRF_ERROR_NULL);
+    TEST_CHECK(ble_cscs_c_continuity_erase(&m_continuity, NULL) == NRF_ERROR_NULL);
+
+    printf("continuity: %u trace steps ok\n", (unsigned)ARRAY_SIZE(m_trace));
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/* Performance counters: each kind of notification and GATT queue error is counted once, the
+ * event handler is timed with the host cycle counter, and a reset clears everything.
+ */
+#define BLE_CSCS_C_COUNTERS_ENABLED 1
+
+#include "test_host.h"
+
+#define HANDLER_SPIN    1000    /**< Iterations of busy work in the event handler. */
+
+static ble_cscs_c_t m_cscs_c;
+static uint32_t     m_evt_count;
+static uint32_t     m_gatt_error_count;
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    volatile uint32_t spin = 0;
+
+    // Work that takes a measurable time on any host.
+    for (uint32_t i = 0; i < HANDLER_SPIN; i++)
+    {
+        spin += i;
+    }
+
+    m_evt_count++;
+}
+
+static void error_handler(uint32_t nrf_error)
+{
+    TEST_CHECK(nrf_error == NRF_ERROR_NO_MEM);
+    m_gatt_error_count++;
+}
+
+static void hvx_send(uint16_t conn_handle, uint16_t handle, uint8_t const * p_data, uint16_t len)
+{
+    test_evt_t evt;
+
+    test_hvx_build(&evt, conn_handle, handle, p_data, len);
+    ble_cscs_c_on_ble_evt(&evt.evt, &m_cscs_c);
+}
+
+int main(void)
+{
+    ble_cscs_c_init_t     init = {.evt_handler = evt_handler, .error_handler = error_handler};
+    ble_cscs_c_counters_t counters;
+    uint8_t               data[11];
+    uint16_t              len;
+
+    test_client_start(&m_cscs_c, &init);
+
+    TEST_CHECK(ble_cscs_c_counters_get(&m_cscs_c, &counters) == NRF_SUCCESS);
+    TEST_CHECK((counters.notif_rx_count == 0) && (counters.handler_call_count == 0));
+    TEST_CHECK((counters.handler_cycles_min == 0) && (counters.handler_cycles_max == 0));
+
+    // 5 measurements, 2 malformed, 3 on another handle and 4 on another link.
+    len = test_meas_encode(data, 0x03, 100, 1024, 50, 1024);
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        hvx_send(TEST_CONN_HANDLE, TEST_CSCM_HANDLE, data, len);
+    }
+    hvx_send(TEST_CONN_HANDLE, TEST_CSCM_HANDLE, data, 3);
+    hvx_send(TEST_CONN_HANDLE, TEST_CSCM_HANDLE, data, 0);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        hvx_send(TEST_CONN_HANDLE, TEST_FEATURE_HANDLE, data, len);
+    }
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        hvx_send(TEST_CONN_HANDLE + 1, TEST_CSCM_HANDLE, data, len);
+    }
+
+    // A CCCD write that the GATT queue fails.
+    TEST_CHECK(ble_cscs_c_csm_notif_enable(&m_cscs_c) == NRF_SUCCESS);
+    test_gq_fail(NRF_ERROR_NO_MEM);
+
+    TEST_CHECK(ble_cscs_c_counters_get(&m_cscs_c, &counters) == NRF_SUCCESS);
+    TEST_CHECK(counters.notif_rx_count == 7);
+    TEST_CHECK(counters.notif_decoded_count == 5);
+    TEST_CHECK(counters.malformed_count == 2);
+    TEST_CHECK(counters.wrong_handle_count == 3);
+    TEST_CHECK(counters.wrong_conn_count == 4);
+    TEST_CHECK((counters.gatt_error_count == 1) && (m_gatt_error_count == 1));
+    TEST_CHECK(counters.handler_call_count == m_evt_count);
+    TEST_CHECK(m_evt_count == 5);
+
+    // Handler times come from the host clock and are never 0.
+    TEST_CHECK(counters.handler_cycles_min > 0);
+    TEST_CHECK(counters.handler_cycles_min <= counters.handler_cycles_avg);
+    TEST_CHECK(counters.handler_cycles_avg <= counters.handler_cycles_max);
+    TEST_CHECK(counters.handler_cycles_sum >= (uint64_t)counters.handler_cycles_min * 5);
+
+    printf("counters: handler min %u ns, avg %u ns, max %u ns\n", (unsigned)counters.handler_cycles_min,
+           (unsigned)counters.handler_cycles_avg, (unsigned)counters.handler_cycles_max);
+
+    TEST_CHECK(ble_cscs_c_counters_reset(&m_cscs_c) == NRF_SUCCESS);
+    TEST_CHECK(ble_cscs_c_counters_get(&m_cscs_c, &counters) == NRF_SUCCESS);
+    TEST_CHECK((counters.notif_rx_count == 0) && (counters.notif_decoded_count == 0));
+    TEST_CHECK((counters.malformed_count == 0) && (counters.wrong_handle_count == 0));
+    TEST_CHECK((counters.wrong_conn_count == 0) && (counters.gatt_error_count == 0));
+    TEST_CHECK((counters.handler_call_count == 0) && (counters.handler_cycles_sum == 0));
+    TEST_CHECK((counters.handler_cycles_min == 0) && (counters.handler_cycles_max == 0));
+
+    // Counting starts over after the reset.
+    hvx_send(TEST_CONN_HANDLE, TEST_CSCM_HANDLE, data, len);
+    TEST_CHECK(ble_cscs_c_counters_get(&m_cscs_c, &counters) == NRF_SUCCESS);
+    TEST_CHECK((counters.notif_decoded_count == 1) && (counters.handler_call_count == 1));
+    TEST_CHECK((counters.handler_cycles_min > 0) && (counters.handler_cycles_min == counters.handler_cycles_max));
+
+    TEST_CHECK(ble_cscs_c_counters_get(NULL, &counters) == NRF_ERROR_NULL);
+    TEST_CHECK(ble_cscs_c_counters_get(&m_cscs_c, NULL) == NRF_ERROR_NULL);
+    TEST_CHECK(ble_cscs_c_counters_reset(NULL) == NRF_ERROR_NULL);
+
+    printf("counters: ok\n");
+
+    return 0;
+}
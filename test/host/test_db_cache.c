@@ -0,0 +1,219 @@
+/* Discovered handle cache with the host file backend: store after discovery, restore after a
+ * reboot, stale handles rejected by the peer, and the time to the first measurement with and
+ * without the cache.
+ */
+#define BLE_CSCS_C_DB_CACHE_ENABLED 1
+
+#include "test_host.h"
+#include "db_cache_file.h"
+
+#define CACHE_PATH          "build/test_db_cache.bin"
+
+#define CONN_INTERVAL_MS    30      /**< Connection interval of the simulated link. */
+#define MEAS_INTERVAL_MS    1000    /**< Interval between two notifications of the sensor. */
+#define DISC_ATT_REQUESTS   7       /**< ATT requests of a Database Discovery of the CSC Service:
+                                         primary service, 3 characteristic and 2 descriptor
+                                         discoveries, and the final characteristic request. */
+#define TTFM_TRIALS         1000    /**< Sensor phases simulated for the time to first measurement. */
+
+static ble_cscs_c_t         m_cscs_c;
+static ble_gap_addr_t const m_peer_addr = {.addr_type = 1, .addr = {0x11, 0x22, 0x33, 0x44, 0x55, 0xC6}};
+static uint32_t             m_evt_count[BLE_CSCS_C_EVT_CONTINUITY + 1];
+
+/**@brief   Event handler doing what an application does: assign discovered handles and enable
+ *          notifications.
+ */
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    m_evt_count[p_evt->evt_type]++;
+
+    if (p_evt->evt_type == BLE_CSCS_C_EVT_DISCOVERY_COMPLETE)
+    {
+        TEST_CHECK(ble_cscs_c_handles_assign(p_ble_cscs_c, p_evt->conn_handle, &p_evt->params.cscs_db) == NRF_SUCCESS);
+        TEST_CHECK(ble_cscs_c_csm_notif_enable(p_ble_cscs_c) == NRF_SUCCESS);
+    }
+}
+
+/**@brief   Function for starting a link as the application does on connection.
+ *
+ * @return  Result of @ref ble_cscs_c_handles_restore.
+ */
+static uint32_t link_start(bool use_cache)
+{
+    ble_cscs_c_init_t init = {.evt_handler = evt_handler, .p_gatt_queue = &test_gatt_queue};
+
+    init.p_db_cache = use_cache ? &db_cache_file : NULL;
+
+    memset(m_evt_count, 0, sizeof(m_evt_count));
+    test_gq_reset();
+    memset(&m_cscs_c, 0, sizeof(m_cscs_c));
+    TEST_CHECK(ble_cscs_c_init(&m_cscs_c, &init) == NRF_SUCCESS);
+
+    uint32_t err_code = ble_cscs_c_handles_restore(&m_cscs_c, TEST_CONN_HANDLE, &m_peer_addr);
+
+    if (err_code == NRF_SUCCESS)
+    {
+        TEST_CHECK(ble_cscs_c_csm_notif_enable(&m_cscs_c) == NRF_SUCCESS);
+    }
+
+    return err_code;
+}
+
+static void discovery_complete(void)
+{
+    ble_db_discovery_evt_t disc_evt;
+
+    test_db_disc_evt_build(&disc_evt, TEST_CONN_HANDLE);
+    ble_cscs_on_db_disc_evt(&m_cscs_c, &disc_evt);
+}
+
+/**@brief   Handles are stored after discovery and restored after a reboot. */
+static void test_store_restore(void)
+{
+    ble_cscs_c_db_t db;
+
+    remove(CACHE_PATH);
+    db_cache_file_open(CACHE_PATH);
+
+    TEST_CHECK(link_start(true) == NRF_ERROR_NOT_FOUND);
+    discovery_complete();
+    TEST_CHECK(m_db_cache_file.store_count == 1);
+    TEST_CHECK(m_evt_count[BLE_CSCS_C_EVT_DISCOVERY_COMPLETE] == 1);
+
+    // Reboot: the table is read back from the file.
+    db_cache_file_open(CACHE_PATH);
+
+    TEST_CHECK(link_start(true) == NRF_SUCCESS);
+    test_db_get(&db);
+    TEST_CHECK(memcmp(&m_cscs_c.peer_db, &db, sizeof(db)) == 0);
+    TEST_CHECK(m_cscs_c.is_peer_db_cached);
+
+    // The CCCD write succeeds, which confirms the cached handles.
+    TEST_CHECK(test_gq_serve(&m_cscs_c)->handle == TEST_CSCM_CCCD_HANDLE);
+    TEST_CHECK(!m_cscs_c.is_peer_db_cached);
+    TEST_CHECK(m_evt_count[BLE_CSCS_C_EVT_DB_CACHE_STALE] == 0);
+}
+
+/**@brief   The peer rejects the CCCD write on cached handles: the entry is erased, every handle
+ *          is invalidated and the application is told to discover again.
+ */
+static void test_stale(void)
+{
+    TEST_CHECK(link_start(true) == NRF_SUCCESS);
+    TEST_CHECK(test_gq_respond(&m_cscs_c, BLE_GATT_STATUS_ATTERR_INVALID_HANDLE, NULL, 0)->handle == TEST_CSCM_CCCD_HANDLE);
+
+    TEST_CHECK(m_evt_count[BLE_CSCS_C_EVT_DB_CACHE_STALE] == 1);
+    TEST_CHECK(m_db_cache_file.erase_count == 1);
+    TEST_CHECK(m_cscs_c.peer_db.cscs_cccd_handle == BLE_GATT_HANDLE_INVALID);
+    TEST_CHECK(m_cscs_c.peer_db.cscs_handle == BLE_GATT_HANDLE_INVALID);
+    TEST_CHECK(m_cscs_c.peer_db.cscs_feature_handle == BLE_GATT_HANDLE_INVALID);
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+    TEST_CHECK(m_cscs_c.peer_db.cscs_sensloc_handle == BLE_GATT_HANDLE_INVALID);
+#endif
+
+    // A notification on the old handle is no longer taken as a measurement.
+    uint8_t data[11];
+
+    test_hvx_send(&m_cscs_c, data, test_meas_encode(data, 0x03, 1, 1, 1, 1));
+    TEST_CHECK(m_evt_count[BLE_CSCS_C_EVT_CSM_NOTIFICATION] == 0);
+
+    // The erase reached the file.
+    db_cache_file_open(CACHE_PATH);
+    TEST_CHECK(link_start(true) == NRF_ERROR_NOT_FOUND);
+    remove(CACHE_PATH);
+}
+
+/**@brief   Function for simulating a connection until the first measurement is delivered.
+ *
+ * @details In each connection event the peer answers one ATT request. Discovery takes
+ *          DISC_ATT_REQUESTS events and then the requests queued by the client are answered in
+ *          order. The sensor notifies every MEAS_INTERVAL_MS from @p phase_ms once its CCCD is set.
+ *
+ * @return  Time from the connection to the first measurement, in ms.
+ */
+static uint32_t ttfm_simulate(bool use_cache, uint32_t phase_ms)
+{
+    uint32_t disc_left    = (link_start(use_cache) == NRF_SUCCESS) ? 0 : DISC_ATT_REQUESTS;
+    bool     is_cccd_set  = false;
+    uint32_t next_meas_ms = phase_ms;
+
+    for (uint32_t event = 1; ; event++)
+    {
+        uint32_t now_ms = event * CONN_INTERVAL_MS;
+
+        if (disc_left > 0)
+        {
+            if (--disc_left == 0)
+            {
+                discovery_complete();
+            }
+        }
+        else
+        {
+            test_gq_req_t const * p_req = test_gq_serve(&m_cscs_c);
+
+            if ((p_req != NULL) && (p_req->handle == TEST_CSCM_CCCD_HANDLE))
+            {
+                is_cccd_set = (p_req->value[0] & BLE_GATT_HVX_NOTIFICATION) != 0;
+            }
+        }
+
+        // The sensor notifies in the first connection event after its measurement.
+        while (next_meas_ms <= now_ms)
+        {
+            if (is_cccd_set)
+            {
+                uint8_t data[11];
+
+                test_hvx_send(&m_cscs_c, data, test_meas_encode(data, 0x03, 1, 1, 1, 1));
+            }
+            next_meas_ms += MEAS_INTERVAL_MS;
+        }
+
+        if (m_evt_count[BLE_CSCS_C_EVT_CSM_NOTIFICATION] > 0)
+        {
+            return now_ms;
+        }
+    }
+}
+
+static void test_time_to_first_meas(void)
+{
+    uint64_t sum_ms[2] = {0, 0};
+    uint32_t max_ms[2] = {0, 0};
+
+    db_cache_file_open(NULL);
+
+    for (uint32_t use_cache = 0; use_cache < 2; use_cache++)
+    {
+        for (uint32_t i = 0; i < TTFM_TRIALS; i++)
+        {
+            uint32_t phase_ms = (uint32_t)((uint64_t)i * MEAS_INTERVAL_MS / TTFM_TRIALS);
+            uint32_t ttfm_ms;
+
+            ttfm_ms = ttfm_simulate(use_cache != 0, phase_ms);
+            sum_ms[use_cache] += ttfm_ms;
+            max_ms[use_cache]  = MAX(max_ms[use_cache], ttfm_ms);
+        }
+    }
+
+    // The cache was filled by the first discovery and skips discovery on every later link.
+    TEST_CHECK(m_db_cache_file.store_count == 1);
+    TEST_CHECK(sum_ms[1] < sum_ms[0]);
+
+    printf("time to first measurement, %u ms connection interval, %u ms sensor interval:\n",
+           CONN_INTERVAL_MS, MEAS_INTERVAL_MS);
+    printf("  %-14s mean %6.1f ms  max %4u ms\n", "discovery", (double)sum_ms[0] / TTFM_TRIALS, (unsigned)max_ms[0]);
+    printf("  %-14s mean %6.1f ms  max %4u ms\n", "cached handles", (double)sum_ms[1] / TTFM_TRIALS, (unsigned)max_ms[1]);
+}
+
+int main(void)
+{
+    test_store_restore();
+    test_stale();
+    test_time_to_first_meas();
+
+    printf("db cache: ok\n");
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+/* CSC Measurement decoding against a field-by-field reference, over the payloads in
+ * corpus/cscm_decode.txt and random payloads, for every mask of fields supported by the peer.
+ */
+#include "test_host.h"
+
+#define CORPUS_PATH     "corpus/cscm_decode.txt"
+#define RANDOM_COUNT    100000  /**< Random payloads decoded after the corpus. */
+#define PAYLOAD_MAX     TEST_EVT_DATA_MAX
+
+static uint32_t          m_notif_count;
+static ble_cscs_c_meas_t m_notif_meas;
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    if (p_evt->evt_type == BLE_CSCS_C_EVT_CSM_NOTIFICATION)
+    {
+        m_notif_count++;
+        m_notif_meas = p_evt->params.csc;
+    }
+}
+
+/**@brief   Reference decoder: walks the fields in order and checks the length before each one. */
+static bool ref_decode(uint8_t const * p_data, uint16_t len, uint8_t flags_mask, ble_cscs_c_meas_t * p_meas)
+{
+    uint16_t index = 0;
+
+    memset(p_meas, 0, sizeof(*p_meas));
+
+    if (len < 1)
+    {
+        return false;
+    }
+
+    uint8_t flags = p_data[index++];
+
+    if (flags & CSCM_FLAG_WHEEL_PRESENT)
+    {
+        if (len < index + 6)
+        {
+            return false;
+        }
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+        if (flags_mask & CSCM_FLAG_WHEEL_PRESENT)
+        {
+            p_meas->is_wheel_rev_data_present = true;
+            p_meas->cumulative_wheel_revs     = uint32_decode(&p_data[index]);
+            p_meas->last_wheel_event_time     = uint16_decode(&p_data[index + 4]);
+        }
+#endif
+        index += 6;
+    }
+
+    if (flags & CSCM_FLAG_CRANK_PRESENT)
+    {
+        if (len < index + 4)
+        {
+            return false;
+        }
+#if BLE_CSCS_C_CRANK_SUPPORTED
+        if (flags_mask & CSCM_FLAG_CRANK_PRESENT)
+        {
+            p_meas->is_crank_rev_data_present = true;
+            p_meas->cumulative_crank_revs     = uint16_decode(&p_data[index]);
+            p_meas->last_crank_event_time     = uint16_decode(&p_data[index + 2]);
+        }
+#endif
+        index += 4;
+    }
+
+    return true;
+}
+
+/**@brief   Function for comparing the fields that are present in both measurements. */
+static bool meas_equal(ble_cscs_c_meas_t const * p_a, ble_cscs_c_meas_t const * p_b)
+{
+#if BLE_CSCS_C_WHEEL_SUPPORTED
+    if ((p_a->is_wheel_rev_data_present != p_b->is_wheel_rev_data_present) ||
+        (p_a->is_wheel_rev_data_present &&
+         ((p_a->cumulative_wheel_revs != p_b->cumulative_wheel_revs) ||
+          (p_a->last_wheel_event_time != p_b->last_wheel_event_time))))
+    {
+        return false;
+    }
+#endif
+#if BLE_CSCS_C_CRANK_SUPPORTED
+    if ((p_a->is_crank_rev_data_present != p_b->is_crank_rev_data_present) ||
+        (p_a->is_crank_rev_data_present &&
+         ((p_a->cumulative_crank_revs != p_b->cumulative_crank_revs) ||
+          (p_a->last_crank_event_time != p_b->last_crank_event_time))))
+    {
+        return false;
+    }
+#endif
+    return true;
+}
+
+/**@brief   Function for checking one payload with csc_meas_decode and with a notification.
+ *
+ * @details The payload is copied to a buffer of its exact length, so that a read past the end is
+ *          caught when built with -fsanitize=address.
+ */
+static void payload_check(ble_cscs_c_t * p_cscs_c, uint8_t const * p_payload, uint16_t len)
+{
+    for (uint8_t flags_mask = 0; flags_mask <= CSCM_FLAG_LAYOUT_MASK; flags_mask++)
+    {
+        uint8_t         * p_copy = malloc(MAX(len, 1));
+        ble_cscs_c_meas_t meas;
+        ble_cscs_c_meas_t ref_meas;
+
+        TEST_CHECK(p_copy != NULL);
+        memcpy(p_copy, p_payload, len);
+
+        memset(&meas, 0, sizeof(meas));
+        bool ref_ok = ref_decode(p_copy, len, flags_mask, &ref_meas);
+        bool ok     = csc_meas_decode(p_copy, len, flags_mask & CSCM_FLAG_SUPPORTED_MASK, &meas);
+
+        TEST_CHECK(ok == ref_ok);
+        TEST_CHECK(!ok || meas_equal(&meas, &ref_meas));
+
+        uint32_t notif_count     = m_notif_count;
+        uint32_t malformed_count = p_cscs_c->malformed_meas_count;
+
+        p_cscs_c->meas_flags_mask = flags_mask & CSCM_FLAG_SUPPORTED_MASK;
+        test_hvx_send(p_cscs_c, p_copy, len);
+
+        TEST_CHECK(m_notif_count == notif_count + (ok ? 1 : 0));
+        TEST_CHECK(p_cscs_c->malformed_meas_count == malformed_count + (ok ? 0 : 1));
+        TEST_CHECK(!ok || meas_equal(&m_notif_meas, &ref_meas));
+
+        free(p_copy);
+    }
+}
+
+/**@brief   Function for parsing a line of hex digits.
+ *
+ * @return  Number of bytes, or -1 if the line is not valid hex.
+ */
+static int hex_parse(char const * p_line, uint8_t * p_data)
+{
+    int len = 0;
+
+    while ((p_line[0] != '\0') && (p_line[0] != '\n') && (p_line[0] != '\r'))
+    {
+        unsigned int byte;
+
+        if ((len == PAYLOAD_MAX) || (sscanf(p_line, "%2x", &byte) != 1) || (p_line[1] == '\0'))
+        {
+            return -1;
+        }
+        p_data[len++] = (uint8_t)byte;
+        p_line += 2;
+    }
+
+    return len;
+}
+
+int main(void)
+{
+    ble_cscs_c_t      cscs_c;
+    ble_cscs_c_init_t init = {.evt_handler = evt_handler};
+    FILE            * p_file;
+    char              line[128];
+    uint8_t           payload[PAYLOAD_MAX];
+    uint32_t          corpus_count = 0;
+
+    test_client_start(&cscs_c, &init);
+
+    p_file = fopen(CORPUS_PATH, "r");
+    TEST_CHECK(p_file != NULL);
+
+    while (fgets(line, sizeof(line), p_file) != NULL)
+    {
+        if (line[0] == '#')
+        {
+            continue;
+        }
+
+        int len = hex_parse(line, payload);
+
+        TEST_CHECK(len >= 0);
+        payload_check(&cscs_c, payload, (uint16_t)len);
+        corpus_count++;
+    }
+    fclose(p_file);
+
+    srand(1816);
+    for (uint32_t i = 0; i < RANDOM_COUNT; i++)
+    {
+        uint16_t len = (uint16_t)(rand() % 16);
+
+        for (uint16_t j = 0; j < len; j++)
+        {
+            payload[j] = (uint8_t)rand();
+        }
+        payload_check(&cscs_c, payload, len);
+    }
+
+    printf("decode: %u corpus and %u random payloads ok\n", (unsigned)corpus_count, RANDOM_COUNT);
+
+    return 0;
+}
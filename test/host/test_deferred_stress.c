@@ -0,0 +1,115 @@
+/* Deferred delivery with the observer and ble_cscs_c_drain on two threads.
+ *
+ * The producer thread passes notifications to ble_cscs_c_on_ble_evt, which queues them with
+ * meas_queue_put. The consumer thread drains them in batches of random size. __DMB() is the
+ * sequentially consistent C11 fence on the host (stubs/sdk_common.h). Every field of a
+ * measurement is derived from its sequence number, so the consumer detects torn, repeated,
+ * reordered and lost measurements.
+ */
+#define BLE_CSCS_C_DEFERRED_ENABLED     1
+#define BLE_CSCS_C_DEFERRED_QUEUE_SIZE  8
+
+#include <pthread.h>
+#include <sched.h>
+#include "test_host.h"
+
+#define NOTIF_COUNT     1000000 /**< Notifications sent by the producer. */
+#define PACED_BLOCK_LEN 16384   /**< Notifications per block of the producer pacing. */
+
+static ble_cscs_c_t     m_cscs_c;
+static volatile bool    m_producer_done;
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    // Measurements are only delivered through ble_cscs_c_drain in this build.
+    TEST_CHECK(p_evt->evt_type != BLE_CSCS_C_EVT_CSM_NOTIFICATION);
+}
+
+static void * producer(void * p_arg)
+{
+    test_evt_t evt;
+    uint8_t    data[11];
+
+    for (uint32_t seq = 0; seq < NOTIF_COUNT; seq++)
+    {
+        uint16_t len = test_meas_encode(data, 0x03, seq, (uint16_t)(seq * 3), (uint16_t)~seq, (uint16_t)(seq >> 16));
+
+        // Wait for room in three blocks out of four, and let the queue overflow in the fourth.
+        while (((seq / PACED_BLOCK_LEN) % 4 != 3) &&
+               ((m_cscs_c.meas_queue.wr_idx - m_cscs_c.meas_queue.rd_idx) == BLE_CSCS_C_DEFERRED_QUEUE_SIZE))
+        {
+            sched_yield();
+        }
+
+        test_hvx_build(&evt, TEST_CONN_HANDLE, TEST_CSCM_HANDLE, data, len);
+        ble_cscs_c_on_ble_evt(&evt.evt, &m_cscs_c);
+    }
+
+    __atomic_store_n(&m_producer_done, true, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+int main(void)
+{
+    ble_cscs_c_init_t init         = {.evt_handler = evt_handler};
+    pthread_t         thread;
+    uint32_t          drained      = 0;
+    uint32_t          next_min_seq = 0;
+    uint32_t          lost         = 0;
+    uint32_t          max_batch    = 0;
+
+    test_client_start(&m_cscs_c, &init);
+    TEST_CHECK(pthread_create(&thread, NULL, producer, NULL) == 0);
+
+    srand(1816);
+    for (;;)
+    {
+        bool              done = __atomic_load_n(&m_producer_done, __ATOMIC_ACQUIRE);
+        ble_cscs_c_meas_t meas[BLE_CSCS_C_DEFERRED_QUEUE_SIZE];
+        uint16_t          count = (uint16_t)(1 + rand() % BLE_CSCS_C_DEFERRED_QUEUE_SIZE);
+
+        TEST_CHECK(ble_cscs_c_drain(&m_cscs_c, meas, &count) == NRF_SUCCESS);
+
+        for (uint16_t i = 0; i < count; i++)
+        {
+            uint32_t seq = meas[i].cumulative_wheel_revs;
+
+            TEST_CHECK(meas[i].is_wheel_rev_data_present && meas[i].is_crank_rev_data_present);
+            TEST_CHECK(meas[i].last_wheel_event_time == (uint16_t)(seq * 3));
+            TEST_CHECK(meas[i].cumulative_crank_revs == (uint16_t)~seq);
+            TEST_CHECK(meas[i].last_crank_event_time == (uint16_t)(seq >> 16));
+            TEST_CHECK((seq >= next_min_seq) && (seq < NOTIF_COUNT));
+
+            lost         += seq - next_min_seq;
+            next_min_seq  = seq + 1;
+        }
+
+        drained   += count;
+        max_batch  = MAX(max_batch, count);
+
+        if (count == 0)
+        {
+            // The write index read by this drain was published before the producer finished.
+            if (done)
+            {
+                break;
+            }
+            sched_yield();
+        }
+    }
+
+    TEST_CHECK(pthread_join(thread, NULL) == 0);
+
+    uint32_t overflow = m_cscs_c.meas_queue.overflow_count;
+
+    // Every measurement was either drained once, in order, or counted as an overflow.
+    TEST_CHECK(drained >= NOTIF_COUNT / 2);
+    TEST_CHECK(lost + (NOTIF_COUNT - next_min_seq) == overflow);
+    TEST_CHECK(drained + overflow == NOTIF_COUNT);
+
+    printf("deferred stress: %u sent, %u drained, %u overflowed, largest batch %u\n",
+           NOTIF_COUNT, (unsigned)drained, (unsigned)overflow, (unsigned)max_batch);
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+/* Measurement filter: duplicates and unchanged measurements are dropped, the rate limit holds back
+ * the latest measurement, and ble_cscs_c_filter_flush passes it on.
+ */
+#define BLE_CSCS_C_FILTER_ENABLED   1
+
+#include "test_host.h"
+
+#define FILTER_INTERVAL_MS  500
+
+static ble_cscs_c_t      m_cscs_c;
+static ble_cscs_c_meas_t m_last;
+static uint32_t          m_meas_count;
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    TEST_CHECK(p_evt->evt_type == BLE_CSCS_C_EVT_CSM_NOTIFICATION);
+    TEST_CHECK(p_evt->conn_handle == TEST_CONN_HANDLE);
+
+    m_last = p_evt->params.csc;
+    m_meas_count++;
+}
+
+static void client_start(ble_cscs_c_filter_mode_t mode, uint16_t interval)
+{
+    ble_cscs_c_init_t init = {.evt_handler     = evt_handler,
+                              .timestamp_get   = test_timestamp_get,
+                              .filter_mode     = mode,
+                              .filter_interval = interval};
+
+    memset(&m_cscs_c, 0, sizeof(m_cscs_c));
+    test_client_start(&m_cscs_c, &init);
+    m_meas_count = 0;
+}
+
+static void meas_send(uint32_t time_ms, uint32_t wheel_revs, uint16_t wheel_time)
+{
+    uint8_t data[11];
+
+    test_now_ms = time_ms;
+    test_hvx_send(&m_cscs_c, data, test_meas_encode(data, 0x01, wheel_revs, wheel_time, 0, 0));
+}
+
+/**@brief   Repeated notifications are dropped by DUPLICATES only when identical, and by ON_CHANGE
+ *          also when only the event time moved.
+ */
+static void test_modes(void)
+{
+    ble_cscs_c_filter_stats_t stats;
+
+    client_start(BLE_CSCS_C_FILTER_DUPLICATES, 0);
+    meas_send(0, 10, 1024);
+    meas_send(1000, 10, 1024);
+    meas_send(2000, 10, 2048);
+    meas_send(3000, 11, 3072);
+    TEST_CHECK(m_meas_count == 3);
+
+    TEST_CHECK(ble_cscs_c_filter_stats_get(&m_cscs_c, &stats) == NRF_SUCCESS);
+    TEST_CHECK((stats.rx_count == 4) && (stats.delivered_count == 3) && (stats.suppressed_permille == 250));
+
+    client_start(BLE_CSCS_C_FILTER_ON_CHANGE, 0);
+    meas_send(0, 10, 1024);
+    meas_send(1000, 10, 1024);
+    meas_send(2000, 10, 2048);
+    meas_send(3000, 11, 3072);
+    TEST_CHECK(m_meas_count == 2);
+    TEST_CHECK(m_last.cumulative_wheel_revs == 11);
+}
+
+/**@brief   The rate limit holds back the latest measurement, which the flush passes on once. */
+static void test_flush(void)
+{
+    client_start(BLE_CSCS_C_FILTER_NONE, FILTER_INTERVAL_MS);
+
+    // Nothing held: the flush passes on nothing.
+    TEST_CHECK(ble_cscs_c_filter_flush(&m_cscs_c) == NRF_SUCCESS);
+    TEST_CHECK(m_meas_count == 0);
+
+    meas_send(0, 10, 1024);
+    meas_send(100, 11, 2048);
+    meas_send(200, 12, 3072);
+    TEST_CHECK((m_meas_count == 1) && (m_last.cumulative_wheel_revs == 10));
+
+    test_now_ms = 300;
+    TEST_CHECK(ble_cscs_c_filter_flush(&m_cscs_c) == NRF_SUCCESS);
+    TEST_CHECK((m_meas_count == 2) && (m_last.cumulative_wheel_revs == 12));
+
+    TEST_CHECK(ble_cscs_c_filter_flush(&m_cscs_c) == NRF_SUCCESS);
+    TEST_CHECK(m_meas_count == 2);
+
+    // The flush restarted the interval.
+    meas_send(700, 13, 4096);
+    TEST_CHECK(m_meas_count == 2);
+    meas_send(800, 14, 5120);
+    TEST_CHECK((m_meas_count == 3) && (m_last.cumulative_wheel_revs == 14));
+
+    TEST_CHECK(ble_cscs_c_filter_flush(NULL) == NRF_ERROR_NULL);
+}
+
+int main(void)
+{
+    test_modes();
+    test_flush();
+
+    printf("filter: ok\n");
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+/* Measurement filter with BLE_CSCS_C_DEFERRED: ble_cscs_c_filter_flush is refused so that the
+ * SoftDevice observer stays the only writer of the queue and the filter state, a held
+ * measurement is superseded by the next one let through, and ble_cscs_c_drain releases it once
+ * the filter interval has passed without one, as when the sensor goes quiet.
+ */
+#define BLE_CSCS_C_DEFERRED_ENABLED 1
+#define BLE_CSCS_C_FILTER_ENABLED   1
+
+#include "test_host.h"
+
+#define FILTER_INTERVAL_MS  500
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+}
+
+static void meas_send(ble_cscs_c_t * p_cscs_c, uint32_t time_ms, uint32_t wheel_revs)
+{
+    uint8_t data[11];
+
+    test_now_ms = time_ms;
+    test_hvx_send(p_cscs_c, data, test_meas_encode(data, 0x01, wheel_revs, (uint16_t)(1024 * wheel_revs), 0, 0));
+}
+
+int main(void)
+{
+    ble_cscs_c_t      cscs_c;
+    ble_cscs_c_meas_t meas[4];
+    uint16_t          count = ARRAY_SIZE(meas);
+    ble_cscs_c_init_t init  = {.evt_handler     = evt_handler,
+                               .timestamp_get   = test_timestamp_get,
+                               .filter_interval = FILTER_INTERVAL_MS};
+
+    test_client_start(&cscs_c, &init);
+
+    meas_send(&cscs_c, 0, 10);
+    meas_send(&cscs_c, 100, 11);
+    TEST_CHECK(cscs_c.filter.is_pending);
+
+    // The flush leaves the queue and the held measurement alone.
+    TEST_CHECK(ble_cscs_c_filter_flush(&cscs_c) == NRF_ERROR_INVALID_STATE);
+    TEST_CHECK(cscs_c.filter.is_pending);
+    TEST_CHECK(cscs_c.meas_queue.wr_idx == 1);
+
+    meas_send(&cscs_c, 600, 12);
+
+    TEST_CHECK(ble_cscs_c_drain(&cscs_c, meas, &count) == NRF_SUCCESS);
+    TEST_CHECK(count == 2);
+    TEST_CHECK(meas[0].cumulative_wheel_revs == 10);
+    TEST_CHECK(meas[1].cumulative_wheel_revs == 12);
+    TEST_CHECK(!cscs_c.filter.is_pending);
+
+    // The sensor goes quiet with a measurement held: drained once the interval has passed.
+    meas_send(&cscs_c, 700, 13);
+    TEST_CHECK(cscs_c.filter.is_pending);
+
+    test_now_ms = 1099;
+    count       = ARRAY_SIZE(meas);
+    TEST_CHECK(ble_cscs_c_drain(&cscs_c, meas, &count) == NRF_SUCCESS);
+    TEST_CHECK((count == 0) && cscs_c.filter.is_pending);
+
+    test_now_ms = 1100;
+    count       = ARRAY_SIZE(meas);
+    TEST_CHECK(ble_cscs_c_drain(&cscs_c, meas, &count) == NRF_SUCCESS);
+    TEST_CHECK((count == 1) && (meas[0].cumulative_wheel_revs == 13));
+    TEST_CHECK(!cscs_c.filter.is_pending);
+    TEST_CHECK(cscs_c.filter.delivered_count == 3);
+
+    // Released once only, and the rate limit starts over from the release.
+    count = ARRAY_SIZE(meas);
+    TEST_CHECK(ble_cscs_c_drain(&cscs_c, meas, &count) == NRF_SUCCESS);
+    TEST_CHECK(count == 0);
+    meas_send(&cscs_c, 1200, 14);
+    TEST_CHECK(cscs_c.filter.is_pending);
+    meas_send(&cscs_c, 1600, 15);
+    count = ARRAY_SIZE(meas);
+    TEST_CHECK(ble_cscs_c_drain(&cscs_c, meas, &count) == NRF_SUCCESS);
+    TEST_CHECK((count == 1) && (meas[0].cumulative_wheel_revs == 15));
+
+    printf("filter deferred: ok\n");
+
+    return 0;
+}
@@ -0,0 +1,246 @@
+/* Speed and cadence fusion of a wheel sensor whose clock runs 300 ppm fast and a crank sensor whose
+ * clock runs 200 ppm slow, over an 80 minute ride.
+ *
+ * Each sensor notifies once per second of its own clock, and the notification is received in the
+ * next connection event of its link, sometimes one event later. The event times of the fused
+ * measurements are compared with the true time of the events on the central clock. The error of
+ * a mapping fixed at the first measurement is shown for comparison. Once the mapping has settled,
+ * the errors and their difference between the sensors must stay bounded for the rest of the ride.
+ * Fused measurements must come out at most twice the maximum latency after the measurement they
+ * carry was received.
+ */
+#define BLE_CSCS_C_FUSION_ENABLED   1
+
+#include <math.h>
+#include "test_host.h"
+#include "ble_cscs_c_fusion.c"
+
+#define RIDE_MS             (80 * 60 * 1000)    /**< Length of the ride. */
+#define SEGMENT_MS          (10 * 60 * 1000)    /**< Length of a row of the report. */
+#define CONN_INTERVAL_MS    30                  /**< Connection interval of both links. */
+#define RETRANSMIT_PERCENT  5                   /**< Share of notifications received one connection event late. */
+#define MAX_LATENCY_MS      100                 /**< Longest wait for the other sensor. */
+#define SETTLE_MS           (10 * 60 * 1000)    /**< Time given to the mapping to find the shortest delay. */
+#define ERROR_MAX_MS        70                  /**< Largest error accepted after SETTLE_MS. */
+#define SKEW_MAX_MS         50                  /**< Largest difference between the errors of both sensors after SETTLE_MS. */
+
+/**@brief   Simulated sensor. */
+typedef struct
+{
+    double            ppm;              /**< Deviation of its clock from the central clock. */
+    double            period_ms;        /**< Mean time between two revolutions. */
+    uint32_t          link_phase_ms;    /**< Time of the first connection event of its link. */
+    double            next_event_ms;    /**< True time of the next revolution. */
+    double            event_ms;         /**< True time of the last revolution. */
+    uint32_t          revs;             /**< Revolutions so far. */
+    uint32_t          notify_count;     /**< Notifications sent so far. */
+    bool              is_in_flight;     /**< True if a notification waits to be received. */
+    uint32_t          rx_ms;            /**< Time the notification in flight is received. */
+    ble_cscs_c_meas_t meas;             /**< Measurement in flight. */
+    double            meas_event_ms;    /**< True time of the revolution in the measurement in flight. */
+    double            rx_event_ms;      /**< True time of the revolution in the last measurement received. */
+    bool              is_waiting;       /**< True if a received measurement is not fused yet. */
+    uint32_t          wait_start_ms;    /**< Time that measurement was received. */
+    bool              is_fixed_set;     /**< True if @p fixed_offset is set. */
+    double            fixed_offset;     /**< Central minus sensor ticks at the first reception. */
+    ble_cscs_c_t      cscs_c;           /**< Client instance of the link. */
+} sensor_t;
+
+/**@brief   Errors collected over a segment, in 1/1024 s. */
+typedef struct
+{
+    int32_t  min[BLE_CSCS_C_FUSION_SOURCE_COUNT];
+    int32_t  max[BLE_CSCS_C_FUSION_SOURCE_COUNT];
+    double   fixed_max[BLE_CSCS_C_FUSION_SOURCE_COUNT];
+    int32_t  skew_max;
+    uint32_t latency_max_ms;
+    uint32_t fused_count;
+} segment_t;
+
+static ble_cscs_c_fusion_t m_fusion;
+static sensor_t            m_sensors[BLE_CSCS_C_FUSION_SOURCE_COUNT];
+static segment_t           m_segment;
+
+/**@brief   Function for getting a time in 1/1024 s of a clock running @p ppm fast. */
+static double ticks_get(double ms, double ppm)
+{
+    return floor(ms * (1.0 + ppm / 1e6) * 1.024);
+}
+
+static void segment_reset(void)
+{
+    memset(&m_segment, 0, sizeof(m_segment));
+
+    for (uint32_t i = 0; i < BLE_CSCS_C_FUSION_SOURCE_COUNT; i++)
+    {
+        m_segment.min[i] = INT32_MAX;
+        m_segment.max[i] = INT32_MIN;
+    }
+}
+
+static void fusion_evt_handler(ble_cscs_c_fusion_t * p_fusion, ble_cscs_c_meas_t const * p_meas)
+{
+    uint16_t const event_times[] = {p_meas->last_wheel_event_time, p_meas->last_crank_event_time};
+    bool const     is_present[]  = {p_meas->is_wheel_rev_data_present, p_meas->is_crank_rev_data_present};
+    int32_t        err[BLE_CSCS_C_FUSION_SOURCE_COUNT];
+
+    for (uint32_t i = 0; i < BLE_CSCS_C_FUSION_SOURCE_COUNT; i++)
+    {
+        sensor_t * p_sensor = &m_sensors[i];
+
+        if (p_sensor->is_waiting)
+        {
+            m_segment.latency_max_ms = MAX(m_segment.latency_max_ms, test_now_ms - p_sensor->wait_start_ms);
+            TEST_CHECK(test_now_ms - p_sensor->wait_start_ms <= 2 * MAX_LATENCY_MS);
+            p_sensor->is_waiting = false;
+        }
+
+        if (!is_present[i])
+        {
+            continue;
+        }
+
+        // Event time on the central clock against the true time of the revolution.
+        double true_ticks = ticks_get(p_sensor->rx_event_ms, 0);
+        double fixed      = ticks_get(p_sensor->rx_event_ms, p_sensor->ppm) + p_sensor->fixed_offset - true_ticks;
+
+        err[i]                   = (int16_t)(event_times[i] - (uint16_t)(uint32_t)true_ticks);
+        m_segment.min[i]         = MIN(m_segment.min[i], err[i]);
+        m_segment.max[i]         = MAX(m_segment.max[i], err[i]);
+        m_segment.fixed_max[i]   = MAX(m_segment.fixed_max[i], fabs(fixed));
+
+        if ((test_now_ms >= SETTLE_MS) && ((err[i] < 0) || (err[i] * 1000 > ERROR_MAX_MS * 1024)))
+        {
+            printf("fusion: error of %d/1024 s on source %u at %u ms\n", (int)err[i], (unsigned)i, (unsigned)test_now_ms);
+            TEST_CHECK(false);
+        }
+    }
+
+    if (is_present[BLE_CSCS_C_FUSION_WHEEL] && is_present[BLE_CSCS_C_FUSION_CRANK])
+    {
+        int32_t skew = err[BLE_CSCS_C_FUSION_WHEEL] - err[BLE_CSCS_C_FUSION_CRANK];
+
+        skew               = (skew < 0) ? -skew : skew;
+        m_segment.skew_max = MAX(m_segment.skew_max, skew);
+        TEST_CHECK((test_now_ms < SETTLE_MS) || (skew * 1000 <= SKEW_MAX_MS * 1024));
+    }
+
+    m_segment.fused_count++;
+}
+
+/**@brief   Function for advancing a sensor to @p now_ms: revolutions, notification, reception. */
+static void sensor_step(sensor_t * p_sensor, ble_cscs_c_fusion_source_id_t id, uint32_t now_ms)
+{
+    while (p_sensor->next_event_ms <= now_ms)
+    {
+        p_sensor->event_ms       = p_sensor->next_event_ms;
+        p_sensor->revs++;
+        // The pace changes slowly over the ride.
+        p_sensor->next_event_ms += p_sensor->period_ms * (1.0 + 0.2 * sin(p_sensor->event_ms / 90000.0));
+    }
+
+    // Notifications every second of the sensor clock.
+    double notify_ms = (p_sensor->notify_count + 1) * 1000.0 / (1.0 + p_sensor->ppm / 1e6);
+
+    if (!p_sensor->is_in_flight && (notify_ms <= now_ms))
+    {
+        uint16_t event_time = (uint16_t)(uint32_t)ticks_get(p_sensor->event_ms, p_sensor->ppm);
+
+        memset(&p_sensor->meas, 0, sizeof(p_sensor->meas));
+        if (id == BLE_CSCS_C_FUSION_WHEEL)
+        {
+            p_sensor->meas.is_wheel_rev_data_present = true;
+            p_sensor->meas.cumulative_wheel_revs     = p_sensor->revs;
+            p_sensor->meas.last_wheel_event_time     = event_time;
+        }
+        else
+        {
+            p_sensor->meas.is_crank_rev_data_present = true;
+            p_sensor->meas.cumulative_crank_revs     = (uint16_t)p_sensor->revs;
+            p_sensor->meas.last_crank_event_time     = event_time;
+        }
+
+        // Received in the next connection event of the link, or in the one after.
+        uint32_t since_phase = now_ms - p_sensor->link_phase_ms;
+
+        p_sensor->rx_ms  = p_sensor->link_phase_ms + (since_phase / CONN_INTERVAL_MS + 1) * CONN_INTERVAL_MS;
+        p_sensor->rx_ms += ((uint32_t)rand() % 100 < RETRANSMIT_PERCENT) ? CONN_INTERVAL_MS : 0;
+
+        p_sensor->meas_event_ms = p_sensor->event_ms;
+        p_sensor->is_in_flight  = true;
+        p_sensor->notify_count++;
+    }
+
+    if (p_sensor->is_in_flight && (p_sensor->rx_ms <= now_ms))
+    {
+        p_sensor->is_in_flight = false;
+        p_sensor->rx_event_ms  = p_sensor->meas_event_ms;
+
+        if (!p_sensor->is_fixed_set)
+        {
+            p_sensor->fixed_offset = ticks_get(now_ms, 0) - ticks_get(p_sensor->rx_event_ms, p_sensor->ppm);
+            p_sensor->is_fixed_set = true;
+        }
+        if (!p_sensor->is_waiting)
+        {
+            p_sensor->is_waiting    = true;
+            p_sensor->wait_start_ms = now_ms;
+        }
+
+        ble_cscs_c_fusion_on_meas(&m_fusion, &p_sensor->cscs_c, &p_sensor->meas);
+    }
+}
+
+int main(void)
+{
+    ble_cscs_c_fusion_init_t init = {.evt_handler    = fusion_evt_handler,
+                                     .timestamp_get  = test_timestamp_get,
+                                     .max_latency_ms = MAX_LATENCY_MS};
+
+    m_sensors[BLE_CSCS_C_FUSION_WHEEL] = (sensor_t){.ppm = 300,  .period_ms = 263, .link_phase_ms = 7};
+    m_sensors[BLE_CSCS_C_FUSION_CRANK] = (sensor_t){.ppm = -200, .period_ms = 690, .link_phase_ms = 22};
+
+    for (uint32_t i = 0; i < BLE_CSCS_C_FUSION_SOURCE_COUNT; i++)
+    {
+        m_sensors[i].next_event_ms      = 100 + 300 * i;
+        m_sensors[i].cscs_c.conn_handle = (uint16_t)i;
+    }
+
+    srand(1402);
+    test_now_ms = 0;
+    TEST_CHECK(ble_cscs_c_fusion_init(&m_fusion, &init) == NRF_SUCCESS);
+    TEST_CHECK(ble_cscs_c_fusion_pair(&m_fusion, 0, 1) == NRF_SUCCESS);
+
+    printf("fusion, wheel clock +300 ppm, crank clock -200 ppm, error of the fused event times in ms:\n");
+    printf("%7s %8s %15s %15s %10s %16s %16s %11s\n", "minute", "fused", "wheel min/max", "crank min/max",
+           "skew max", "fixed wheel max", "fixed crank max", "latency max");
+
+    segment_reset();
+
+    for (test_now_ms = 1; test_now_ms <= RIDE_MS; test_now_ms++)
+    {
+        sensor_step(&m_sensors[BLE_CSCS_C_FUSION_WHEEL], BLE_CSCS_C_FUSION_WHEEL, test_now_ms);
+        sensor_step(&m_sensors[BLE_CSCS_C_FUSION_CRANK], BLE_CSCS_C_FUSION_CRANK, test_now_ms);
+
+        if ((test_now_ms % MAX_LATENCY_MS) == 0)
+        {
+            ble_cscs_c_fusion_process(&m_fusion);
+        }
+
+        if ((test_now_ms % SEGMENT_MS) == 0)
+        {
+            printf("%3u-%-3u %8u %7.1f/%-7.1f %7.1f/%-7.1f %10.1f %16.1f %16.1f %11u\n",
+                   (unsigned)((test_now_ms - SEGMENT_MS) / 60000), (unsigned)(test_now_ms / 60000),
+                   (unsigned)m_segment.fused_count,
+                   m_segment.min[0] / 1.024, m_segment.max[0] / 1.024,
+                   m_segment.min[1] / 1.024, m_segment.max[1] / 1.024,
+                   m_segment.skew_max / 1.024, m_segment.fixed_max[0] / 1.024, m_segment.fixed_max[1] / 1.024,
+                   (unsigned)m_segment.latency_max_ms);
+            segment_reset();
+        }
+    }
+
+    printf("fusion: ok\n");
+
+    return 0;
+}
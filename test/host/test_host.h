@@ -0,0 +1,411 @@
+/* Host test support for the CSC client.
+ *
+ * Each test, benchmark or tool is one translation unit that defines the BLE_CSCS_C_* options it
+ * needs, then includes this file. This file builds ble_cscs_c.c into the unit and provides the
+ * SDK services the client calls:
+ * - a GATT queue that records requests until the test answers them
+ * - a SoftDevice observer loop
+ * - a millisecond clock, and a ns clock standing in for the cycle counter
+ * It also provides helpers that build BLE events.
+ */
+#ifndef TEST_HOST_H__
+#define TEST_HOST_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "ble_cscs_c.c"
+
+/**@brief   Check that holds in every build, unlike assert(). */
+#define TEST_CHECK(_cond)                                                                \
+    do                                                                                   \
+    {                                                                                    \
+        if (!(_cond))                                                                    \
+        {                                                                                \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #_cond);   \
+            exit(EXIT_FAILURE);                                                          \
+        }                                                                                \
+    } while (0)
+
+#define TEST_CONN_HANDLE        0x0000  /**< Connection handle used by single-link tests. */
+#define TEST_CSCM_HANDLE        0x0010  /**< Handle of the CSC Measurement value. */
+#define TEST_CSCM_CCCD_HANDLE   0x0011  /**< Handle of the CSC Measurement CCCD. */
+#define TEST_FEATURE_HANDLE     0x0013  /**< Handle of the CSC Feature value. */
+#define TEST_SENSLOC_HANDLE     0x0015  /**< Handle of the Sensor Location value. */
+#define TEST_FEATURE_VALUE      0x0003  /**< CSC Feature returned by the peer: wheel and crank data. */
+#define TEST_SENSLOC_VALUE      0x05    /**< Sensor Location returned by the peer: left crank. */
+
+#define TEST_GQ_SIZE            64      /**< Number of GATT queue requests kept for the test. */
+#define TEST_EVT_DATA_MAX       32      /**< Largest attribute value carried by a test event. */
+
+/**@brief   BLE event with room for the attribute value. */
+typedef union
+{
+    ble_evt_t evt;
+    uint8_t   raw[sizeof(ble_evt_t) + TEST_EVT_DATA_MAX];
+} test_evt_t;
+
+/**@brief   GATT queue request recorded by the stub. */
+typedef struct
+{
+    nrf_ble_gq_req_type_t     type;
+    uint16_t                  conn_handle;
+    uint16_t                  handle;
+    uint16_t                  len;
+    uint8_t                   value[TEST_EVT_DATA_MAX];
+    nrf_ble_gq_req_error_cb_t error_cb;     /**< Error handler of the request. */
+    void                    * p_error_ctx;  /**< Context of the error handler. */
+} test_gq_req_t;
+
+/**@brief   State of the GATT queue stub. Requests are kept in order until taken by the test. */
+typedef struct
+{
+    test_gq_req_t reqs[TEST_GQ_SIZE];
+    uint32_t      head;         /**< Index of the oldest request not taken. */
+    uint32_t      tail;         /**< Index of the next request to record. */
+    uint32_t      write_count;  /**< Number of write requests recorded. */
+    uint32_t      read_count;   /**< Number of read requests recorded. */
+    uint32_t      err_code;     /**< Error returned by nrf_ble_gq_item_add, NRF_SUCCESS to accept. */
+    uint32_t      err_skip;     /**< Requests accepted before err_code is returned. */
+} test_gq_t;
+
+test_gq_t      test_gq;
+nrf_ble_gq_t   test_gatt_queue;
+uint32_t       test_now_ms;
+
+uint32_t ble_db_discovery_evt_register(ble_uuid_t const * p_uuid)
+{
+    return NRF_SUCCESS;
+}
+
+uint32_t nrf_ble_gq_conn_handle_register(nrf_ble_gq_t * p_gatt_queue, uint16_t conn_handle)
+{
+    return NRF_SUCCESS;
+}
+
+uint32_t nrf_ble_gq_item_add(nrf_ble_gq_t const * p_gatt_queue, nrf_ble_gq_req_t * p_req, uint16_t conn_handle)
+{
+    if (test_gq.err_code != NRF_SUCCESS)
+    {
+        if (test_gq.err_skip == 0)
+        {
+            return test_gq.err_code;
+        }
+        test_gq.err_skip--;
+    }
+
+    TEST_CHECK(test_gq.tail - test_gq.head < TEST_GQ_SIZE);
+
+    test_gq_req_t * p_rec = &test_gq.reqs[test_gq.tail++ % TEST_GQ_SIZE];
+
+    memset(p_rec, 0, sizeof(*p_rec));
+    p_rec->type        = p_req->type;
+    p_rec->conn_handle = conn_handle;
+    p_rec->error_cb    = p_req->error_handler.cb;
+    p_rec->p_error_ctx = p_req->error_handler.p_ctx;
+
+    if (p_req->type == NRF_BLE_GQ_REQ_GATTC_WRITE)
+    {
+        p_rec->handle = p_req->params.gattc_write.handle;
+        p_rec->len    = MIN(p_req->params.gattc_write.len, TEST_EVT_DATA_MAX);
+        memcpy(p_rec->value, p_req->params.gattc_write.p_value, p_rec->len);
+        test_gq.write_count++;
+    }
+    else
+    {
+        p_rec->handle = p_req->params.gattc_read.handle;
+        test_gq.read_count++;
+    }
+
+    return NRF_SUCCESS;
+}
+
+/**@brief   Function for forgetting all recorded GATT queue requests. */
+static inline void test_gq_reset(void)
+{
+    memset(&test_gq, 0, sizeof(test_gq));
+}
+
+/**@brief   Function for counting the requests not taken yet. */
+static inline uint32_t test_gq_pending(void)
+{
+    return test_gq.tail - test_gq.head;
+}
+
+/**@brief   Function for taking the oldest request, or NULL if there is none. */
+static inline test_gq_req_t const * test_gq_take(void)
+{
+    return (test_gq.head == test_gq.tail) ? NULL : &test_gq.reqs[test_gq.head++ % TEST_GQ_SIZE];
+}
+
+/**@brief   Function for peeking at the newest request, or NULL if none was recorded. */
+static inline test_gq_req_t const * test_gq_last(void)
+{
+    return (test_gq.tail == 0) ? NULL : &test_gq.reqs[(test_gq.tail - 1) % TEST_GQ_SIZE];
+}
+
+uint32_t sd_ble_gap_conn_param_update(uint16_t conn_handle, ble_gap_conn_params_t const * p_conn_params)
+{
+    return NRF_SUCCESS;
+}
+
+/**@brief   Function for failing the oldest request, as the GATT queue does when the SoftDevice
+ *          rejects it: no response follows, only the error handler of the request is called.
+ *
+ * @return  The request failed; the test fails if there was none.
+ */
+static inline test_gq_req_t const * test_gq_fail(uint32_t nrf_error)
+{
+    test_gq_req_t const * p_req = test_gq_take();
+
+    TEST_CHECK(p_req != NULL);
+    if (p_req->error_cb != NULL)
+    {
+        p_req->error_cb(nrf_error, p_req->p_error_ctx, p_req->conn_handle);
+    }
+
+    return p_req;
+}
+
+/**@brief   Function for getting the test clock, usable as ble_cscs_c_init_t::timestamp_get. */
+static inline uint32_t test_timestamp_get(void)
+{
+    return test_now_ms;
+}
+
+/**@brief   Function for reading a monotonic clock in ns, for benchmarks. */
+static inline uint64_t test_ns_get(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+uint32_t test_cycle_count_get(void)
+{
+    return (uint32_t)test_ns_get();
+}
+
+extern nrf_sdh_ble_evt_observer_t __start_sdh_ble_observers[] __attribute__((weak));
+extern nrf_sdh_ble_evt_observer_t __stop_sdh_ble_observers[] __attribute__((weak));
+
+/**@brief   Function for passing an event to every registered observer, as the SoftDevice handler does. */
+static inline void nrf_sdh_ble_evt_send(ble_evt_t const * p_ble_evt)
+{
+    for (nrf_sdh_ble_evt_observer_t * p_obs = __start_sdh_ble_observers; p_obs < __stop_sdh_ble_observers; p_obs++)
+    {
+        if (p_obs->handler != NULL)
+        {
+            p_obs->handler(p_ble_evt, p_obs->p_context);
+        }
+    }
+}
+
+/**@brief   Function for encoding a CSC Measurement.
+ *
+ * @param[out] p_data   Buffer of at least 11 bytes.
+ * @param[in]  flags    Flags field; bit 0 adds the wheel fields, bit 1 the crank fields.
+ *
+ * @return     Length of the measurement.
+ */
+static inline uint16_t test_meas_encode(uint8_t  * p_data,
+                                        uint8_t    flags,
+                                        uint32_t   wheel_revs,
+                                        uint16_t   wheel_time,
+                                        uint16_t   crank_revs,
+                                        uint16_t   crank_time)
+{
+    uint16_t len = 0;
+
+    p_data[len++] = flags;
+    if (flags & 0x01)
+    {
+        len += uint32_encode(wheel_revs, &p_data[len]);
+        len += uint16_encode(wheel_time, &p_data[len]);
+    }
+    if (flags & 0x02)
+    {
+        len += uint16_encode(crank_revs, &p_data[len]);
+        len += uint16_encode(crank_time, &p_data[len]);
+    }
+
+    return len;
+}
+
+/**@brief   Function for building a Handle Value Notification event. */
+static inline void test_hvx_build(test_evt_t    * p_evt,
+                                  uint16_t        conn_handle,
+                                  uint16_t        handle,
+                                  uint8_t const * p_data,
+                                  uint16_t        len)
+{
+    TEST_CHECK(len <= TEST_EVT_DATA_MAX);
+
+    memset(p_evt, 0, sizeof(*p_evt));
+    p_evt->evt.header.evt_id                 = BLE_GATTC_EVT_HVX;
+    p_evt->evt.evt.gattc_evt.conn_handle     = conn_handle;
+    p_evt->evt.evt.gattc_evt.params.hvx.handle = handle;
+    p_evt->evt.evt.gattc_evt.params.hvx.type = BLE_GATT_HVX_NOTIFICATION;
+    p_evt->evt.evt.gattc_evt.params.hvx.len  = len;
+    memcpy(p_evt->evt.evt.gattc_evt.params.hvx.data, p_data, len);
+}
+
+/**@brief   Function for passing a CSC Measurement notification to an instance. */
+static inline void test_hvx_send(ble_cscs_c_t * p_ble_cscs_c, uint8_t const * p_data, uint16_t len)
+{
+    test_evt_t evt;
+
+    test_hvx_build(&evt, p_ble_cscs_c->conn_handle, TEST_CSCM_HANDLE, p_data, len);
+    ble_cscs_c_on_ble_evt(&evt.evt, p_ble_cscs_c);
+}
+
+/**@brief   Function for building the response to a GATT queue request. */
+static inline void test_rsp_build(test_evt_t          * p_evt,
+                                  test_gq_req_t const * p_req,
+                                  uint16_t              gatt_status,
+                                  uint8_t const       * p_data,
+                                  uint16_t              len)
+{
+    ble_gattc_evt_t * p_gattc_evt = &p_evt->evt.evt.gattc_evt;
+
+    TEST_CHECK(len <= TEST_EVT_DATA_MAX);
+
+    memset(p_evt, 0, sizeof(*p_evt));
+    p_gattc_evt->conn_handle  = p_req->conn_handle;
+    p_gattc_evt->gatt_status  = gatt_status;
+    p_gattc_evt->error_handle = (gatt_status == BLE_GATT_STATUS_SUCCESS) ? BLE_GATT_HANDLE_INVALID : p_req->handle;
+
+    if (p_req->type == NRF_BLE_GQ_REQ_GATTC_WRITE)
+    {
+        p_evt->evt.header.evt_id          = BLE_GATTC_EVT_WRITE_RSP;
+        p_gattc_evt->params.write_rsp.handle = p_req->handle;
+        p_gattc_evt->params.write_rsp.len    = p_req->len;
+    }
+    else
+    {
+        p_evt->evt.header.evt_id         = BLE_GATTC_EVT_READ_RSP;
+        p_gattc_evt->params.read_rsp.handle = p_req->handle;
+        p_gattc_evt->params.read_rsp.len    = len;
+        memcpy(p_gattc_evt->params.read_rsp.data, p_data, len);
+    }
+}
+
+/**@brief   Function for answering the oldest GATT queue request on an instance.
+ *
+ * @return  The request answered; the test fails if there was none.
+ */
+static inline test_gq_req_t const * test_gq_respond(ble_cscs_c_t  * p_ble_cscs_c,
+                                                    uint16_t        gatt_status,
+                                                    uint8_t const * p_data,
+                                                    uint16_t        len)
+{
+    test_gq_req_t const * p_req = test_gq_take();
+    test_evt_t            evt;
+
+    TEST_CHECK(p_req != NULL);
+    test_rsp_build(&evt, p_req, gatt_status, p_data, len);
+    ble_cscs_c_on_ble_evt(&evt.evt, p_ble_cscs_c);
+
+    return p_req;
+}
+
+/**@brief   Function for answering the oldest GATT queue request successfully, as the peer does
+ *          in one connection event. Reads of the CSC Feature and Sensor Location return
+ *          TEST_FEATURE_VALUE and TEST_SENSLOC_VALUE.
+ *
+ * @return  The request answered, or NULL if there was none.
+ */
+static inline test_gq_req_t const * test_gq_serve(ble_cscs_c_t * p_ble_cscs_c)
+{
+    uint8_t  data[2];
+    uint16_t len = 0;
+
+    if (test_gq_pending() == 0)
+    {
+        return NULL;
+    }
+
+    test_gq_req_t const * p_req = &test_gq.reqs[test_gq.head % TEST_GQ_SIZE];
+
+    if ((p_req->type == NRF_BLE_GQ_REQ_GATTC_READ) && (p_req->handle == TEST_FEATURE_HANDLE))
+    {
+        len = uint16_encode(TEST_FEATURE_VALUE, data);
+    }
+    else if ((p_req->type == NRF_BLE_GQ_REQ_GATTC_READ) && (p_req->handle == TEST_SENSLOC_HANDLE))
+    {
+        data[len++] = TEST_SENSLOC_VALUE;
+    }
+
+    return test_gq_respond(p_ble_cscs_c, BLE_GATT_STATUS_SUCCESS, data, len);
+}
+
+/**@brief   Function for building the Database Discovery result of a peer with the test handles. */
+static inline void test_db_disc_evt_build(ble_db_discovery_evt_t * p_evt, uint16_t conn_handle)
+{
+    ble_gatt_db_srv_t * p_db = &p_evt->params.discovered_db;
+
+    memset(p_evt, 0, sizeof(*p_evt));
+    p_evt->evt_type      = BLE_DB_DISCOVERY_COMPLETE;
+    p_evt->conn_handle   = conn_handle;
+    p_db->srv_uuid.uuid  = BLE_UUID_CYCLING_SPEED_AND_CADENCE;
+    p_db->srv_uuid.type  = BLE_UUID_TYPE_BLE;
+    p_db->char_count     = 3;
+
+    p_db->charateristics[0].characteristic.uuid.uuid    = BLE_UUID_CSC_MEASUREMENT_CHAR;
+    p_db->charateristics[0].characteristic.handle_value = TEST_CSCM_HANDLE;
+    p_db->charateristics[0].cccd_handle                 = TEST_CSCM_CCCD_HANDLE;
+    p_db->charateristics[1].characteristic.uuid.uuid    = BLE_UUID_CSC_FEATURE_CHAR;
+    p_db->charateristics[1].characteristic.handle_value = TEST_FEATURE_HANDLE;
+    p_db->charateristics[2].characteristic.uuid.uuid    = BLE_UUID_SENSOR_LOCATION_CHAR;
+    p_db->charateristics[2].characteristic.handle_value = TEST_SENSLOC_HANDLE;
+}
+
+/**@brief   Function for building a Disconnected event. */
+static inline void test_disconnected_build(test_evt_t * p_evt, uint16_t conn_handle)
+{
+    memset(p_evt, 0, sizeof(*p_evt));
+    p_evt->evt.header.evt_id          = BLE_GAP_EVT_DISCONNECTED;
+    p_evt->evt.evt.gap_evt.conn_handle = conn_handle;
+}
+
+/**@brief   Function for passing a Disconnected event to an instance. */
+static inline void test_disconnected_send(ble_cscs_c_t * p_ble_cscs_c)
+{
+    test_evt_t evt;
+
+    test_disconnected_build(&evt, p_ble_cscs_c->conn_handle);
+    ble_cscs_c_on_ble_evt(&evt.evt, p_ble_cscs_c);
+}
+
+/**@brief   Function for filling in the handles used by the tests. */
+static inline void test_db_get(ble_cscs_c_db_t * p_db)
+{
+    memset(p_db, 0, sizeof(*p_db));
+    p_db->cscs_handle         = TEST_CSCM_HANDLE;
+    p_db->cscs_cccd_handle    = TEST_CSCM_CCCD_HANDLE;
+    p_db->cscs_feature_handle = TEST_FEATURE_HANDLE;
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+    p_db->cscs_sensloc_handle = TEST_SENSLOC_HANDLE;
+#endif
+}
+
+/**@brief   Function for initializing an instance and assigning it the test link.
+ *
+ * @param[out]    p_ble_cscs_c  Instance.
+ * @param[in,out] p_init        Initialization structure; the GATT queue is filled in.
+ */
+static inline void test_client_start(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_init_t * p_init)
+{
+    ble_cscs_c_db_t db;
+
+    memset(p_ble_cscs_c, 0, sizeof(*p_ble_cscs_c));
+    p_init->p_gatt_queue = &test_gatt_queue;
+    TEST_CHECK(ble_cscs_c_init(p_ble_cscs_c, p_init) == NRF_SUCCESS);
+
+    test_db_get(&db);
+    TEST_CHECK(ble_cscs_c_handles_assign(p_ble_cscs_c, TEST_CONN_HANDLE, &db) == NRF_SUCCESS);
+}
+
+#endif // TEST_HOST_H__
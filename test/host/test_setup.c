@@ -0,0 +1,129 @@
+/* Setup: BLE_CSCS_C_EVT_READY once all the requests of ble_cscs_c_setup have completed, including
+ * requests the GATT queue fails, and no READY after a setup that could not queue all its requests.
+ */
+#include "test_host.h"
+
+/**@brief   What happens to each request of the setup, in queue order. */
+typedef enum
+{
+    REQ_SERVE,      /**< The peer answers. */
+    REQ_FAIL        /**< The GATT queue fails the request, no response follows. */
+} req_op_t;
+
+static ble_cscs_c_t       m_cscs_c;
+static ble_cscs_c_ready_t m_ready;
+static uint32_t           m_ready_count;
+static uint32_t           m_error_count;
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    if (p_evt->evt_type == BLE_CSCS_C_EVT_READY)
+    {
+        m_ready = p_evt->params.ready;
+        m_ready_count++;
+    }
+}
+
+static void error_handler(uint32_t nrf_error)
+{
+    TEST_CHECK(nrf_error == NRF_ERROR_NO_MEM);
+    m_error_count++;
+}
+
+static void client_start(void)
+{
+    ble_cscs_c_init_t init = {.evt_handler = evt_handler, .error_handler = error_handler};
+
+    test_gq_reset();
+    m_ready_count = 0;
+    m_error_count = 0;
+    test_client_start(&m_cscs_c, &init);
+}
+
+/**@brief   Function for running a setup whose CCCD write, Feature read and Sensor Location read
+ *          are served or failed as given, and checking the READY event that follows.
+ */
+static void setup_run(req_op_t cccd, req_op_t feature, req_op_t sensloc)
+{
+    req_op_t ops[]  = {cccd, feature, sensloc};
+    uint32_t errors = m_error_count;
+
+    m_ready_count = 0;
+    TEST_CHECK(ble_cscs_c_setup(&m_cscs_c) == NRF_SUCCESS);
+    TEST_CHECK(test_gq_pending() == 2 + BLE_CSCS_C_SENSLOC_SUPPORTED);
+
+    for (uint32_t i = 0; i < 2 + BLE_CSCS_C_SENSLOC_SUPPORTED; i++)
+    {
+        TEST_CHECK(m_ready_count == 0);
+        if (ops[i] == REQ_SERVE)
+        {
+            test_gq_serve(&m_cscs_c);
+        }
+        else
+        {
+            test_gq_fail(NRF_ERROR_NO_MEM);
+        }
+    }
+
+    TEST_CHECK(m_ready_count == 1);
+    TEST_CHECK(m_error_count == errors + (cccd == REQ_FAIL) + (feature == REQ_FAIL) +
+                                (BLE_CSCS_C_SENSLOC_SUPPORTED && (sensloc == REQ_FAIL)));
+    TEST_CHECK(m_ready.is_notif_enabled == (cccd == REQ_SERVE));
+    TEST_CHECK(m_ready.is_feature_present == (feature == REQ_SERVE));
+    TEST_CHECK(!m_ready.is_feature_present || (m_ready.feature == TEST_FEATURE_VALUE));
+#if BLE_CSCS_C_SENSLOC_SUPPORTED
+    TEST_CHECK(m_ready.is_sensor_location_present == (sensloc == REQ_SERVE));
+    TEST_CHECK(!m_ready.is_sensor_location_present || (m_ready.sensor_location == TEST_SENSLOC_VALUE));
+#endif
+}
+
+/**@brief   Each combination of served and failed requests ends in one READY, and the next setup
+ *          is accepted.
+ */
+static void test_gq_errors(void)
+{
+    client_start();
+
+    for (uint32_t mask = 0; mask < 8; mask++)
+    {
+        setup_run((mask & 1) ? REQ_FAIL : REQ_SERVE,
+                  (mask & 2) ? REQ_FAIL : REQ_SERVE,
+                  (mask & 4) ? REQ_FAIL : REQ_SERVE);
+    }
+}
+
+/**@brief   A setup that cannot queue all its requests returns the error, sends no READY for the
+ *          requests it queued, and can be retried.
+ */
+static void test_queue_full(void)
+{
+    for (uint32_t accepted = 0; accepted < 1 + BLE_CSCS_C_SENSLOC_SUPPORTED + 1; accepted++)
+    {
+        client_start();
+
+        test_gq.err_code = NRF_ERROR_NO_MEM;
+        test_gq.err_skip = accepted;
+        TEST_CHECK(ble_cscs_c_setup(&m_cscs_c) == NRF_ERROR_NO_MEM);
+        TEST_CHECK(test_gq_pending() == accepted);
+        test_gq.err_code = NRF_SUCCESS;
+
+        while (test_gq_serve(&m_cscs_c) != NULL)
+        {
+        }
+        TEST_CHECK(m_ready_count == 0);
+
+        setup_run(REQ_SERVE, REQ_SERVE, REQ_SERVE);
+        TEST_CHECK(ble_cscs_c_setup(&m_cscs_c) == NRF_SUCCESS);
+        TEST_CHECK(ble_cscs_c_setup(&m_cscs_c) == NRF_ERROR_BUSY);
+    }
+}
+
+int main(void)
+{
+    test_gq_errors();
+    test_queue_full();
+
+    printf("setup: ok\n");
+
+    return 0;
+}
@@ -0,0 +1,204 @@
+/* Ride statistics: random rides checked after every measurement against a brute-force reference
+ * that keeps every sample and recomputes each window from scratch.
+ *
+ * Rides mix several measurements in one second, pauses, gaps longer than the long window,
+ * distance restarts as on a new link, and lap resets. Half of them cross the wrap of the 32-bit
+ * ms time stamp; the reference counts seconds from the first measurement on a 64-bit clock.
+ */
+#define BLE_CSCS_C_CALC_ENABLED     1
+#define BLE_CSCS_C_STATS_ENABLED    1
+
+#include "test_host.h"
+#include "ble_cscs_c_stats.c"
+
+#define RIDE_COUNT      200     /**< Random rides. */
+#define RIDE_LEN        3000    /**< Measurements per ride. */
+#define LAP_CHECK_RATE  37      /**< Measurements between two checks of the lap. */
+#define WRAP_RANGE      (1u << 22)  /**< Rides crossing the wrap start this many ms before it at most. */
+
+/**@brief   Measurement as kept by the reference. */
+typedef struct
+{
+    uint32_t sec;               /**< Second since the first measurement of the ride. */
+    bool     is_speed_valid;
+    uint32_t speed;
+    bool     is_cadence_valid;
+    uint16_t cadence;
+    uint32_t distance;          /**< Distance added by this measurement, in metres. */
+    bool     is_moving;
+} sample_t;
+
+static sample_t           m_samples[RIDE_LEN];
+static ble_cscs_c_stats_t m_stats;
+
+/**@brief   Function for computing the statistics of the samples [first, last] whose second is
+ *          above @p min_sec, one by one.
+ */
+static void reference_get(uint32_t first, uint32_t last, int64_t min_sec, ble_cscs_c_stats_result_t * p_result)
+{
+    uint64_t speed_sum   = 0;
+    uint32_t speed_count = 0;
+    int64_t  moving_sec  = -1;
+
+    memset(p_result, 0, sizeof(*p_result));
+
+    for (uint32_t i = first; i <= last; i++)
+    {
+        sample_t const * p_sample = &m_samples[i];
+
+        if ((int64_t)p_sample->sec <= min_sec)
+        {
+            continue;
+        }
+        if (p_sample->is_speed_valid)
+        {
+            speed_sum += p_sample->speed;
+            speed_count++;
+        }
+        if (p_sample->is_cadence_valid)
+        {
+            p_result->max_cadence = MAX(p_result->max_cadence, p_sample->cadence);
+        }
+        if (p_sample->is_moving && ((int64_t)p_sample->sec != moving_sec))
+        {
+            p_result->moving_time++;
+            moving_sec = p_sample->sec;
+        }
+        p_result->distance += p_sample->distance;
+    }
+
+    p_result->avg_speed = (speed_count != 0) ? (uint32_t)(speed_sum / speed_count) : 0;
+}
+
+static void result_check(ble_cscs_c_stats_window_id_t window, ble_cscs_c_stats_result_t const * p_expected)
+{
+    ble_cscs_c_stats_result_t result;
+
+    TEST_CHECK(ble_cscs_c_stats_get(&m_stats, window, &result) == NRF_SUCCESS);
+    TEST_CHECK(result.avg_speed == p_expected->avg_speed);
+    TEST_CHECK(result.max_cadence == p_expected->max_cadence);
+    TEST_CHECK(result.distance == p_expected->distance);
+    TEST_CHECK(result.moving_time == p_expected->moving_time);
+}
+
+/**@brief   Function for checking a window against the samples of its last seconds. */
+static void window_check(ble_cscs_c_stats_window_id_t window, uint32_t size, uint32_t last)
+{
+    int64_t                   min_sec = (int64_t)m_samples[last].sec - size;
+    uint32_t                  first   = last;
+    ble_cscs_c_stats_result_t expected;
+
+    while ((first > 0) && ((int64_t)m_samples[first - 1].sec > min_sec))
+    {
+        first--;
+    }
+
+    reference_get(first, last, min_sec, &expected);
+    result_check(window, &expected);
+}
+
+static uint32_t ms_step_get(void)
+{
+    uint32_t r = (uint32_t)rand() % 100;
+
+    if (r < 2)
+    {
+        return 40000 + (uint32_t)rand() % 20000;    // Longer than the long window.
+    }
+    if (r < 10)
+    {
+        return 1000 + (uint32_t)rand() % 5000;      // Pause.
+    }
+
+    return (uint32_t)rand() % 700;                  // Several measurements per second at times.
+}
+
+static void ride_check(uint32_t seed)
+{
+    uint64_t time;
+    uint64_t start;             // Time of the first measurement, where the seconds of the windows start.
+    uint32_t distance               = 0;
+    uint32_t prev_distance          = 0;
+    bool     is_prev_distance_valid = false;
+    uint32_t lap_first              = 0;
+
+    srand(seed);
+    time  = ((seed % 2) != 0) ? ((1ull << 32) - (uint32_t)rand() % WRAP_RANGE) : (uint32_t)rand() % (1u << 30);
+    start = time;
+    TEST_CHECK(ble_cscs_c_stats_init(&m_stats) == NRF_SUCCESS);
+
+    for (uint32_t i = 0; i < RIDE_LEN; i++)
+    {
+        sample_t        * p_sample = &m_samples[i];
+        ble_cscs_c_meas_t meas;
+
+        time += ms_step_get();
+        start = (i == 0) ? time : start;
+
+        memset(&meas, 0, sizeof(meas));
+        meas.calc.is_speed_valid   = (rand() % 10) != 0;
+        meas.calc.speed            = ((rand() % 5) != 0) ? (uint32_t)rand() % 15000 : 0;
+        meas.calc.is_cadence_valid = (rand() % 5) != 0;
+        meas.calc.cadence          = ((rand() % 5) != 0) ? (uint16_t)(rand() % 1500) : 0;
+
+        // The distance of the calculation restarts from 0 on a new link.
+        distance = ((rand() % 200) == 0) ? (uint32_t)rand() % 5 : distance + (uint32_t)rand() % 10;
+        meas.calc.distance = distance;
+
+        memset(p_sample, 0, sizeof(*p_sample));
+        p_sample->sec              = (uint32_t)((time - start) / 1000);
+        p_sample->is_speed_valid   = meas.calc.is_speed_valid;
+        p_sample->speed            = meas.calc.speed;
+        p_sample->is_cadence_valid = meas.calc.is_cadence_valid;
+        p_sample->cadence          = meas.calc.cadence;
+        p_sample->is_moving        = (meas.calc.is_speed_valid && (meas.calc.speed != 0)) ||
+                                     (meas.calc.is_cadence_valid && (meas.calc.cadence != 0));
+
+        // Distance added since the previous measurement with a speed, unless the distance restarted.
+        if (meas.calc.is_speed_valid)
+        {
+            if (is_prev_distance_valid && (distance >= prev_distance))
+            {
+                p_sample->distance = distance - prev_distance;
+            }
+            prev_distance          = distance;
+            is_prev_distance_valid = true;
+        }
+
+        ble_cscs_c_stats_update(&m_stats, (uint32_t)time, &meas);
+
+        window_check(BLE_CSCS_C_STATS_SHORT, BLE_CSCS_C_STATS_SHORT_WINDOW, i);
+        window_check(BLE_CSCS_C_STATS_LONG, BLE_CSCS_C_STATS_LONG_WINDOW, i);
+
+        if ((i % LAP_CHECK_RATE) == 0)
+        {
+            ble_cscs_c_stats_result_t expected;
+
+            reference_get(lap_first, i, -1, &expected);
+            result_check(BLE_CSCS_C_STATS_LAP, &expected);
+        }
+        if ((rand() % 500) == 0)
+        {
+            TEST_CHECK(ble_cscs_c_stats_lap_reset(&m_stats) == NRF_SUCCESS);
+            lap_first = i + 1;
+        }
+    }
+}
+
+int main(void)
+{
+    ble_cscs_c_stats_result_t result;
+
+    for (uint32_t ride = 0; ride < RIDE_COUNT; ride++)
+    {
+        ride_check(ride);
+    }
+
+    TEST_CHECK(ble_cscs_c_stats_init(NULL) == NRF_ERROR_NULL);
+    TEST_CHECK(ble_cscs_c_stats_get(&m_stats, (ble_cscs_c_stats_window_id_t)3, &result) == NRF_ERROR_INVALID_PARAM);
+
+    printf("stats: %u random rides of %u measurements ok, %u across the time stamp wrap\n",
+           RIDE_COUNT, RIDE_LEN, RIDE_COUNT / 2);
+
+    return 0;
+}
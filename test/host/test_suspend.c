@@ -0,0 +1,258 @@
+/* Notification suspend: GATT operations over a parked period with and without the policy, the
+ * CCCD writes of the application going through the state machine, so that notifications turned
+ * off by the application are never probed, and CCCD writes of the policy failed by the GATT queue.
+ *
+ * The peer answers one queued request per connection event and notifies every second while its
+ * CCCD is set, with unchanged counters while the bike is parked.
+ */
+#define BLE_CSCS_C_SUSPEND_ENABLED  1
+
+#include "test_host.h"
+
+#define CONN_INTERVAL_MS    100     /**< Connection interval of the simulated link. */
+#define NOTIF_INTERVAL_MS   1000    /**< Notification interval of the sensor. */
+#define SUSPEND_TIMEOUT_MS  10000
+#define PROBE_INTERVAL_MS   60000
+#define PARKED_MS           (30 * 60000)
+
+static ble_cscs_c_t m_cscs_c;
+static bool         m_is_cccd_set;      /**< CCCD value at the peer. */
+static uint32_t     m_wheel_revs;
+static uint32_t     m_hvx_count;
+static uint32_t     m_suspended_count;
+static uint32_t     m_resumed_count;
+
+static void evt_handler(ble_cscs_c_t * p_ble_cscs_c, ble_cscs_c_evt_t * p_evt)
+{
+    switch (p_evt->evt_type)
+    {
+        case BLE_CSCS_C_EVT_SUSPENDED:
+            m_suspended_count++;
+            break;
+
+        case BLE_CSCS_C_EVT_RESUMED:
+            m_resumed_count++;
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void client_start(void)
+{
+    ble_cscs_c_init_t init = {.evt_handler     = evt_handler,
+                              .timestamp_get   = test_timestamp_get,
+                              .suspend_timeout = SUSPEND_TIMEOUT_MS,
+                              .probe_interval  = PROBE_INTERVAL_MS};
+
+    test_gq_reset();
+    test_now_ms       = 0;
+    m_is_cccd_set     = false;
+    m_wheel_revs      = 0;
+    m_hvx_count       = 0;
+    m_suspended_count = 0;
+    m_resumed_count   = 0;
+    test_client_start(&m_cscs_c, &init);
+}
+
+/**@brief   Function for answering the oldest queued request, as the peer does in a connection event. */
+static void peer_serve(void)
+{
+    test_gq_req_t const * p_req = test_gq_serve(&m_cscs_c);
+
+    if ((p_req != NULL) && (p_req->handle == TEST_CSCM_CCCD_HANDLE))
+    {
+        m_is_cccd_set = (p_req->value[0] & BLE_GATT_HVX_NOTIFICATION) != 0;
+    }
+}
+
+/**@brief   Function for running the link for @p duration_ms, with the wheel turning if @p is_moving. */
+static void run(uint32_t duration_ms, bool is_moving)
+{
+    for (uint32_t end_ms = test_now_ms + duration_ms; test_now_ms < end_ms; )
+    {
+        test_now_ms += CONN_INTERVAL_MS;
+        peer_serve();
+
+        if ((test_now_ms % NOTIF_INTERVAL_MS) == 0)
+        {
+            if (m_is_cccd_set)
+            {
+                uint8_t data[11];
+
+                m_wheel_revs += is_moving ? 2 : 0;
+                test_hvx_send(&m_cscs_c, data, test_meas_encode(data, 0x01, m_wheel_revs, 0, 0, 0));
+                m_hvx_count++;
+            }
+            ble_cscs_c_suspend_process(&m_cscs_c);
+        }
+    }
+}
+
+/**@brief   Over a parked period, the notifications and CCCD writes with the policy are a fraction of
+ *          the notifications without it, the statistics estimate the notifications saved, and the
+ *          sensor is probed back on once the ride goes on.
+ */
+static void test_parked(void)
+{
+    ble_cscs_c_suspend_stats_t stats;
+
+    client_start();
+    TEST_CHECK(ble_cscs_c_csm_notif_enable(&m_cscs_c) == NRF_SUCCESS);
+    run(60000, true);
+    TEST_CHECK(m_is_cccd_set && (m_suspended_count == 0));
+
+    uint32_t hvx_count   = m_hvx_count;
+    uint32_t write_count = test_gq.write_count;
+    uint32_t baseline    = PARKED_MS / NOTIF_INTERVAL_MS;
+
+    run(PARKED_MS, false);
+    hvx_count   = m_hvx_count - hvx_count;
+    write_count = test_gq.write_count - write_count;
+
+    TEST_CHECK(ble_cscs_c_suspend_stats_get(&m_cscs_c, &stats) == NRF_SUCCESS);
+    printf("suspend: parked %u min, %u notifications and %u CCCD writes instead of %u notifications, "
+           "%u notifications saved by the statistics\n", PARKED_MS / 60000, (unsigned)hvx_count,
+           (unsigned)write_count, (unsigned)baseline, (unsigned)stats.notif_saved_count);
+
+    TEST_CHECK((hvx_count + write_count) * 10 < baseline);
+    TEST_CHECK(write_count == stats.cccd_write_count);
+    // Each probe costs a few seconds on top of the probe interval.
+    TEST_CHECK((stats.probe_count >= PARKED_MS / PROBE_INTERVAL_MS - 2) &&
+               (stats.probe_count <  PARKED_MS / PROBE_INTERVAL_MS));
+    TEST_CHECK(abs((int)stats.notif_saved_count - (int)(baseline - hvx_count)) <= (int)baseline / 20);
+
+    // The next probe finds the wheel turning.
+    run(PROBE_INTERVAL_MS + 5000, true);
+    TEST_CHECK(m_is_cccd_set && (m_cscs_c.suspend.state == BLE_CSCS_C_SUSPEND_ACTIVE));
+    run(60000, true);
+    TEST_CHECK(m_is_cccd_set && (m_cscs_c.suspend.state == BLE_CSCS_C_SUSPEND_ACTIVE));
+}
+
+/**@brief   Turning off notifications the policy suspended costs no write, stops the probes, and
+ *          only ble_cscs_c_csm_notif_enable turns them on again.
+ */
+static void test_disable_suspended(void)
+{
+    ble_cscs_c_suspend_stats_t stats;
+
+    client_start();
+    TEST_CHECK(ble_cscs_c_csm_notif_enable(&m_cscs_c) == NRF_SUCCESS);
+    run(60000, false);
+    TEST_CHECK(!m_is_cccd_set && (m_cscs_c.suspend.state == BLE_CSCS_C_SUSPEND_SUSPENDED));
+
+    uint32_t write_count = test_gq.write_count;
+    uint32_t hvx_count   = m_hvx_count;
+
+    TEST_CHECK(ble_cscs_c_csm_notif_disable(&m_cscs_c) == NRF_SUCCESS);
+    TEST_CHECK(m_cscs_c.suspend.state == BLE_CSCS_C_SUSPEND_DISABLED);
+    run(10 * PROBE_INTERVAL_MS, true);
+    TEST_CHECK((test_gq.write_count == write_count) && (m_hvx_count == hvx_count));
+    TEST_CHECK(ble_cscs_c_resume(&m_cscs_c) == NRF_ERROR_INVALID_STATE);
+    TEST_CHECK(test_gq.write_count == write_count);
+
+    TEST_CHECK(ble_cscs_c_suspend_stats_get(&m_cscs_c, &stats) == NRF_SUCCESS);
+    TEST_CHECK(stats.probe_count == 0);
+    TEST_CHECK(stats.suspended_time < 60000);
+
+    TEST_CHECK(ble_cscs_c_csm_notif_enable(&m_cscs_c) == NRF_SUCCESS);
+    TEST_CHECK(test_gq.write_count == write_count + 1);
+    run(60000, true);
+    TEST_CHECK(m_is_cccd_set && (m_cscs_c.suspend.state == BLE_CSCS_C_SUSPEND_ACTIVE));
+
+    // The policy works again once the application turned notifications on.
+    run(SUSPEND_TIMEOUT_MS + 2000, false);
+    TEST_CHECK(!m_is_cccd_set && (m_cscs_c.suspend.state == BLE_CSCS_C_SUSPEND_SUSPENDED));
+}
+
+/**@brief   Notifications turned off by the application while on are not probed. */
+static void test_disable_active(void)
+{
+    client_start();
+    TEST_CHECK(ble_cscs_c_csm_notif_enable(&m_cscs_c) == NRF_SUCCESS);
+    run(20000, true);
+
+    uint32_t write_count = test_gq.write_count;
+
+    TEST_CHECK(ble_cscs_c_csm_notif_disable(&m_cscs_c) == NRF_SUCCESS);
+    run(10 * PROBE_INTERVAL_MS, false);
+    TEST_CHECK(!m_is_cccd_set && (test_gq.write_count == write_count + 1));
+    TEST_CHECK((m_suspended_count == 0) && (m_resumed_count == 0));
+}
+
+/**@brief   A CCCD write of the application supersedes the pending write of the policy. */
+static void test_pending_write(void)
+{
+    // Disabled while a probe turns notifications on: both writes reach the peer, in order.
+    client_start();
+    TEST_CHECK(ble_cscs_c_csm_notif_enable(&m_cscs_c) == NRF_SUCCESS);
+    run(PROBE_INTERVAL_MS, false);
+    while (m_cscs_c.suspend.state != BLE_CSCS_C_SUSPEND_RESUMING)
+    {
+        run(CONN_INTERVAL_MS, false);
+    }
+    TEST_CHECK(ble_cscs_c_csm_notif_disable(&m_cscs_c) == NRF_SUCCESS);
+    TEST_CHECK(test_gq_pending() == 2);
+    run(10 * PROBE_INTERVAL_MS, true);
+    TEST_CHECK(!m_is_cccd_set && (m_resumed_count == 0));
+    TEST_CHECK(m_cscs_c.suspend.state == BLE_CSCS_C_SUSPEND_DISABLED);
+
+    // Enabled while the policy turns notifications off: notifications end up on.
+    client_start();
+    TEST_CHECK(ble_cscs_c_csm_notif_enable(&m_cscs_c) == NRF_SUCCESS);
+    while (m_cscs_c.suspend.state != BLE_CSCS_C_SUSPEND_SUSPENDING)
+    {
+        run(CONN_INTERVAL_MS, false);
+    }
+    TEST_CHECK(ble_cscs_c_csm_notif_enable(&m_cscs_c) == NRF_SUCCESS);
+    run(5000, true);
+    TEST_CHECK(m_is_cccd_set && (m_suspended_count == 0));
+    TEST_CHECK(m_cscs_c.suspend.state == BLE_CSCS_C_SUSPEND_ACTIVE);
+}
+
+/**@brief   A CCCD write of the policy that the GATT queue fails leaves the notifications as they
+ *          were, and the policy goes on.
+ */
+static void test_gq_error(void)
+{
+    client_start();
+    TEST_CHECK(ble_cscs_c_csm_notif_enable(&m_cscs_c) == NRF_SUCCESS);
+
+    // Suspend failed: back to active, and a resume is not refused as busy.
+    while (m_cscs_c.suspend.state != BLE_CSCS_C_SUSPEND_SUSPENDING)
+    {
+        run(CONN_INTERVAL_MS, false);
+    }
+    test_gq_fail(NRF_ERROR_NO_MEM);
+    TEST_CHECK(m_is_cccd_set && (m_cscs_c.suspend.state == BLE_CSCS_C_SUSPEND_ACTIVE));
+    TEST_CHECK(ble_cscs_c_resume(&m_cscs_c) == NRF_SUCCESS);
+    TEST_CHECK(test_gq_pending() == 0);
+
+    run(SUSPEND_TIMEOUT_MS + 2000, false);
+    TEST_CHECK(!m_is_cccd_set && (m_cscs_c.suspend.state == BLE_CSCS_C_SUSPEND_SUSPENDED));
+
+    // Probe failed: back to suspended, then resumed by the application.
+    while (m_cscs_c.suspend.state != BLE_CSCS_C_SUSPEND_RESUMING)
+    {
+        run(CONN_INTERVAL_MS, false);
+    }
+    test_gq_fail(NRF_ERROR_NO_MEM);
+    TEST_CHECK(!m_is_cccd_set && (m_cscs_c.suspend.state == BLE_CSCS_C_SUSPEND_SUSPENDED));
+    TEST_CHECK(ble_cscs_c_resume(&m_cscs_c) == NRF_SUCCESS);
+    TEST_CHECK(m_cscs_c.suspend.state == BLE_CSCS_C_SUSPEND_RESUMING);
+    run(5000, true);
+    TEST_CHECK(m_is_cccd_set && (m_cscs_c.suspend.state == BLE_CSCS_C_SUSPEND_ACTIVE));
+    TEST_CHECK((m_suspended_count == 1) && (m_resumed_count == 1));
+}
+
+int main(void)
+{
+    test_parked();
+    test_disable_suspended();
+    test_disable_active();
+    test_pending_write();
+    test_gq_error();
+
+    return 0;
+}